@@ -0,0 +1,52 @@
+#include "aimetrics.h"
+
+AIMetrics& AIMetrics::instance()
+{
+    static AIMetrics instance;
+    return instance;
+}
+
+void AIMetrics::increment(const QString &counter, qint64 amount)
+{
+    m_counters[counter] += amount;
+    m_pending[counter] += amount;
+}
+
+void AIMetrics::recordLatency(const QString &target, qint64 ms)
+{
+    increment(target + ".latency.count");
+    increment(target + ".latency.total_ms", ms);
+
+    qint64 &max = m_counters[target + ".latency.max_ms"];
+    if (ms > max) {
+        max = ms;
+    }
+    qint64 &pendingMax = m_pending[target + ".latency.max_ms"];
+    if (ms > pendingMax) {
+        pendingMax = ms;
+    }
+
+    m_histograms[target].record(ms);
+}
+
+LatencyHistogram AIMetrics::histogram(const QString &target) const
+{
+    return m_histograms.value(target);
+}
+
+qint64 AIMetrics::value(const QString &counter) const
+{
+    return m_counters.value(counter, 0);
+}
+
+QMap<QString, qint64> AIMetrics::counters() const
+{
+    return m_counters;
+}
+
+QMap<QString, qint64> AIMetrics::takePending()
+{
+    QMap<QString, qint64> pending;
+    pending.swap(m_pending);
+    return pending;
+}
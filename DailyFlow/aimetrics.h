@@ -0,0 +1,37 @@
+#ifndef AIMETRICS_H
+#define AIMETRICS_H
+
+#include <QMap>
+#include <QString>
+#include "latencyhistogram.h"
+
+// AIService 동작을 관찰하기 위한 카운터 모음
+// 이름 규칙: "<대상>.<항목>" (예: "summary.requests", "weather.deduplicated")
+class AIMetrics
+{
+public:
+    static AIMetrics& instance();
+
+    void increment(const QString &counter, qint64 amount = 1);
+
+    // 호출 지연 기록 - "<대상>.latency.count/total_ms/max_ms" 카운터와 대상별 히스토그램에 누적
+    void recordLatency(const QString &target, qint64 ms);
+    LatencyHistogram histogram(const QString &target) const;
+    qint64 value(const QString &counter) const;
+    QMap<QString, qint64> counters() const;
+
+    // 마지막 호출 이후 늘어난 양 (일별 집계 테이블에 더하기 위한 것, 가져가면 비워짐)
+    // ".max_ms" 항목은 증가량이 아니라 그 사이의 최댓값
+    QMap<QString, qint64> takePending();
+
+private:
+    AIMetrics() = default;
+    AIMetrics(const AIMetrics&) = delete;
+    AIMetrics& operator=(const AIMetrics&) = delete;
+
+    QMap<QString, qint64> m_counters;
+    QMap<QString, LatencyHistogram> m_histograms;
+    QMap<QString, qint64> m_pending;
+};
+
+#endif // AIMETRICS_H
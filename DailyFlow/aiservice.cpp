@@ -1,16 +1,69 @@
 #include "aiservice.h"
 #include "datamanager.h"
 #include "envloader.h"
+#include "sseparser.h"
+#include "aimetrics.h"
+#include "promptbudget.h"
+#include "localsummarizer.h"
+#include "regionresolver.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QEventLoop>
+#include <QTimer>
+#include <QCoreApplication>
 #include <QUrlQuery>
+#include <QRegularExpression>
 #include <QDate>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QCryptographicHash>
+#include <QPointer>
 #include <QDebug>
+#include <algorithm>
+#include <climits>
+
+// 응답의 usage 필드를 토큰 카운터에 누적
+static void recordUsage(const QJsonObject &usage){
+    if(usage.isEmpty()) {
+        return;
+    }
+    AIMetrics::instance().increment("openai.prompt_tokens", usage["prompt_tokens"].toInt());
+    AIMetrics::instance().increment("openai.completion_tokens", usage["completion_tokens"].toInt());
+}
+
+QString WeatherInfo::text() const{
+    if(!valid) {
+        return "날씨 정보를 가져올 수 없습니다.";
+    }
+    return QString("%1, 기온 %2°C, 습도 %3%")
+        .arg(description)
+        .arg(temperature, 0, 'f', 1)  // 소수점 1자리
+        .arg(humidity);
+}
+
+WeatherInfo DayForecast::toWeatherInfo() const{
+    WeatherInfo info;
+    info.valid = date.isValid();
+    info.description = description;
+    info.temperature = temperature;
+    info.humidity = humidity;
+    return info;
+}
+
+QString DayForecast::shortText() const{
+    QString text = QString("%1 %2~%3°C")
+                       .arg(description)
+                       .arg(qRound(minTemp))
+                       .arg(qRound(maxTemp));
+    if(precipitationChance >= 30) {
+        text += QString(" ☔%1%").arg(precipitationChance);
+    }
+    return text;
+}
 
 AIService& AIService::instance(){
     static AIService instance;
@@ -19,308 +72,1394 @@ AIService& AIService::instance(){
 
 AIService::AIService() : m_networkManager(new QNetworkAccessManager(this))
 {
-    openai_apikey = EnvLoader::get("OPENAI_API_KEY");
     weather_apikey = EnvLoader::get("WEATHER_API_KEY");
 
-    if(openai_apikey.isEmpty()){
-        qCritical() << "OPENAI_API_KEY is not set!";
+    // 스트리밍 응답 사용 여부 (기본 사용)
+    m_streamEnabled = EnvLoader::get("OPENAI_STREAM", "true").toLower() != "false";
+
+    // 홈 화면의 요약과 운세를 한 번의 호출로 생성할지 (기본 사용)
+    m_combinedEnabled = EnvLoader::get("AI_COMBINED_MODE", "true").toLower() != "false";
+
+    // 날씨 캐시 유효 시간 (분) - 응답의 Cache-Control/Expires가 더 짧으면 그 값을 따름
+    m_weatherTtlSeconds = EnvLoader::get("WEATHER_CACHE_TTL_MINUTES", "30").toInt() * 60;
+
+    // 외부 API별 시간 제한/재시도 정책
+    // OpenAI는 스트림 중 토큰 간격이 길 수 있어 여유 있게, 날씨는 짧게
+    m_llmEndpoints = LlmEndpoint::fromEnvironment();
+    for(const LlmEndpoint &endpoint : m_llmEndpoints) {
+        EndpointPolicy &policy = m_endpoints[endpoint.name];
+        policy.host = endpoint.url.host();
+        policy.encrypted = endpoint.url.scheme() == "https";
+        policy.port = quint16(endpoint.url.port(policy.encrypted ? 443 : 80));
+        policy.timeoutMs = EnvLoader::get("OPENAI_TIMEOUT_MS", "30000").toInt();
+    }
+    // 날씨 API 주소 (WEATHER_BASE_URL 로 로컬 대역 서버를 가리킬 수 있음)
+    m_weatherBaseUrl = EnvLoader::get("WEATHER_BASE_URL", "https://api.openweathermap.org/data/2.5");
+    while(m_weatherBaseUrl.endsWith('/')) {
+        m_weatherBaseUrl.chop(1);
+    }
+    QUrl weatherUrl(m_weatherBaseUrl);
+    m_endpoints["weather"].host = weatherUrl.host();
+    m_endpoints["weather"].encrypted = weatherUrl.scheme() == "https";
+    m_endpoints["weather"].port = quint16(weatherUrl.port(m_endpoints["weather"].encrypted ? 443 : 80));
+    m_endpoints["weather"].timeoutMs = EnvLoader::get("WEATHER_TIMEOUT_MS", "5000").toInt();
+
+    // 예보 캐시 유효 시간 (분) - 예보는 3시간 간격으로 갱신됨
+    m_forecastTtlSeconds = EnvLoader::get("FORECAST_CACHE_TTL_MINUTES", "180").toInt() * 60;
+
+    // 주간 요약을 한 번의 호출에 몇 일씩 묶을지 (작게 하면 여러 호출이 동시에 출발)
+    m_weekBatchSize = qMax(1, EnvLoader::get("WEEK_SUMMARY_BATCH_DAYS", "7").toInt());
+
+    // 일정 목록에 쓸 수 있는 프롬프트 토큰 수
+    m_scheduleTokenBudget = EnvLoader::get("PROMPT_SCHEDULE_TOKEN_BUDGET", "600").toInt();
+
+    // 로그인 중 미리 연결 (false 로 두면 첫 호출의 cold 지연을 측정할 수 있음)
+    m_prewarmEnabled = EnvLoader::get("AI_PREWARM", "true").toLower() != "false";
+
+    // 헤지 요청을 보내기 전 최소 대기 시간 (p95 가 아주 짧아도 중복 요청을 남발하지 않도록)
+    m_hedgeMinMs = EnvLoader::get("LLM_HEDGE_MIN_MS", "300").toInt();
+
+    if(m_llmEndpoints.isEmpty()){
+        qCritical() << "OPENAI_API_KEY is not set! (or configure LLM_ENDPOINTS)";
     }
 
     if(weather_apikey.isEmpty()){
         qCritical() << "WEATHER_API_KEY is not set!";
     }
+
+    // 사용량 카운터는 1분마다, 그리고 종료 직전에 일별 집계 테이블(ai_usage_daily)에 더함
+    m_usageFlushTimer = new QTimer(this);
+    m_usageFlushTimer->setTimerType(Qt::VeryCoarseTimer);
+    m_usageFlushTimer->setInterval(60 * 1000);
+    connect(m_usageFlushTimer, &QTimer::timeout, this, &AIService::flushUsage);
+    m_usageFlushTimer->start();
+    if(QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &AIService::flushUsage);
+    }
 }
 
 AIService::~AIService(){
     // QObject의 부모-자식 관계로 자동 삭제됨
 }
 
-QString AIService::generateDailySummary(int userId){
-    // 1. 사용자 정보 가져오기
-    QVariantMap userInfo = DataManager::instance().getUserInfo(userId);
-    QString userName = userInfo["name"].toString();
-    QString userAddress = userInfo["address"].toString();
-    QString userBirth = userInfo["dateOfBirth"].toString();
+void AIService::requestHomeContent(int userId){
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    bool summaryCached = !DataManager::instance().getCachedSummary(userId, today).isEmpty();
+    bool fortuneCached = !DataManager::instance().getCachedFortune(userId, today).isEmpty();
 
-    // 주소에서 지역명 파싱
-    QString location = parseLocationFromAddress(userAddress);
-    if(location.isEmpty()) {
-        location = "Seoul";  // 기본값
+    // 둘 다 없으면 한 번의 호출로 함께 생성 (사용자 정보/날짜를 한 번만 보냄)
+    if(m_combinedEnabled && !summaryCached && !fortuneCached) {
+        requestCombinedContent(userId, QDate::currentDate());
+        return;
     }
 
-    // 2. 오늘 날짜
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
-    QString todayKorean = QDate::currentDate().toString("M월 d일 dddd");
+    // 운세는 날씨/일정과 무관하므로 요약의 준비 단계와 동시에 바로 출발
+    requestTodaysFortune(userId);
+    requestDailySummary(userId);
+}
+
+void AIService::requestCombinedContent(int userId, const QDate &date){
+    AIMetrics::instance().increment("combined.requests");
+
+    auto job = std::make_shared<SummaryJob>();
+    job->userId = userId;
+    job->date = date.toString("yyyy-MM-dd");
+    job->dateKorean = date.toString("M월 d일 dddd");
+    job->dayLabel = (date == QDate::currentDate()) ? "오늘" : "이날";
+    job->combined = true;
+
+    // 어느 한쪽이라도 진행 중이면 개별 경로로 보내서 그 요청에 합류
+    QString summaryKey = QString("summary:%1:%2").arg(userId).arg(job->date);
+    QString fortuneKey = QString("fortune:%1:%2").arg(userId).arg(job->date);
+    if(m_inflight.contains(summaryKey) || m_inflight.contains(fortuneKey)) {
+        requestTodaysFortune(userId, false, date);
+        requestDailySummary(userId, false, date);
+        return;
+    }
+    job->flightKey = summaryKey;
+    job->generation = m_generation;
+    m_inflight.insert(summaryKey, m_generation);
+    m_inflight.insert(fortuneKey, m_generation);
+
+    QVariantMap userInfo = DataManager::instance().getUserInfo(userId);
+    job->userName = userInfo["name"].toString();
+    job->fortune = fortuneProfile(userInfo, date);
+
+    startSummaryInputs(job, userInfo["address"].toString());
+}
+
+void AIService::requestDailySummary(int userId, bool forceRefresh, const QDate &date){
+    AIMetrics::instance().increment("summary.requests");
+
+    auto job = std::make_shared<SummaryJob>();
+    job->userId = userId;
+    job->date = date.toString("yyyy-MM-dd");
+    job->dateKorean = date.toString("M월 d일 dddd");
+    job->dayLabel = (date == QDate::currentDate()) ? "오늘" : "이날";
+    job->forceRefresh = forceRefresh;
 
-    // 3. 캐시 확인
-    QString cached = DataManager::instance().getCachedSummary(userId, today);
+    // 1. 캐시 확인 - 호출자는 항상 시그널로 결과를 받도록 다음 이벤트 루프에서 전달
+    QString cached = forceRefresh ? QString() : DataManager::instance().getCachedSummary(userId, job->date);
+    AIMetrics::instance().increment(cached.isEmpty() ? "summary.cache_misses" : "summary.cache_hits");
     if(!cached.isEmpty()) {
-        qDebug() << "Using cached summary for" << today;
-        return cached;
+        qDebug() << "Using cached summary for" << job->date;
+        QTimer::singleShot(0, this, [this, job, cached]() {
+            emit dailySummaryReady(job->userId, job->date, cached);
+        });
+        return;
     }
 
-    // 4. 오늘 일정 가져오기
-    QList<QVariantMap> schedules = DataManager::instance().getSchedulesByDate(userId, today);
+    // 2. 같은 (userId, date) 요청이 진행 중이면 합류 - 결과 시그널을 함께 받음
+    job->flightKey = QString("summary:%1:%2").arg(userId).arg(job->date);
+    if(!beginFlight(job->flightKey, "summary")) {
+        return;
+    }
+    job->generation = m_generation;
 
-    // 5. 날씨 정보 가져오기
-    QString weatherInfo = getWeather(location);
+    // 사용자 정보 가져오기
+    QVariantMap userInfo = DataManager::instance().getUserInfo(userId);
+    job->userName = userInfo["name"].toString();
 
-    // 6. 일정 정보를 텍스트로 정리
-    QString schedulesText;
-    if(schedules.isEmpty()) {
-        schedulesText = "오늘은 등록된 일정이 없습니다.";
+    startSummaryInputs(job, userInfo["address"].toString());
+}
+
+void AIService::startSummaryInputs(const std::shared_ptr<SummaryJob> &job, const QString &userAddress){
+    // 3. 날씨 요청을 가장 먼저 출발시킴 (주소 → 시/군/구 좌표)
+    RegionLocation location = RegionResolver::resolve(userAddress);
+    if(job->date == QDate::currentDate().toString("yyyy-MM-dd")) {
+        getWeather(location, [this, job](const WeatherInfo &weather) {
+            job->weather = weather;
+            job->weatherReady = true;
+            advanceSummaryJob(job);
+        });
     } else {
-        schedulesText = QString("오늘은 총 %1개의 일정이 있습니다:\n").arg(schedules.size());
-        for(const QVariantMap& schedule : schedules) {
-            schedulesText += QString("- %1 %2")
-            .arg(schedule["startTime"].toString())
-                .arg(schedule["title"].toString());
-
-            if(!schedule["location"].toString().isEmpty()) {
-                schedulesText += QString(" (%1)").arg(schedule["location"].toString());
-            }
-            if(!schedule["endTime"].toString().isEmpty()) {
-                schedulesText += QString(" ~ %1").arg(schedule["endTime"].toString());
+        // 다른 날짜(다음 날 미리 생성)는 현재 날씨 대신 그 날의 예보 사용
+        getForecast(location, [this, job](const QList<DayForecast> &days) {
+            for(const DayForecast &day : days) {
+                if(day.date.toString("yyyy-MM-dd") == job->date) {
+                    job->weather = day.toWeatherInfo();
+                    break;
+                }
             }
-            schedulesText += "\n";
+            job->weatherReady = true;
+            advanceSummaryJob(job);
+        });
+    }
 
-            if(!schedule["memo"].toString().isEmpty()) {
-                schedulesText += QString("  메모: %1\n").arg(schedule["memo"].toString());
-            }
+    // 4. 날씨 응답을 기다리는 동안 해당 날짜의 일정 가져오기
+    job->schedules = DataManager::instance().getSchedulesByDate(job->userId, job->date);
+    job->schedulesText = buildSchedulesText(job->schedules, job->dayLabel);
+    job->schedulesReady = true;
+
+    // 날씨가 아직이면 일정만으로 만든 로컬 요약을 먼저 전달 (날씨가 오면 날씨를 넣어 다시 전달)
+    if(!job->weatherReady) {
+        emit dailySummaryDraft(job->userId, job->date, localSummary(*job));
+    }
+    advanceSummaryJob(job);
+}
+
+void AIService::advanceSummaryJob(const std::shared_ptr<SummaryJob> &job){
+    // 날씨/예보를 기다리는 동안 cancelAll 되었으면 LLM 호출 없이 버림
+    if(job->generation != m_generation) {
+        qDebug() << "Dropping cancelled summary job" << job->flightKey;
+        return;
+    }
+    if(!job->weatherReady || !job->schedulesReady) {
+        return;
+    }
+
+    // 일정 수정이 프롬프트 입력을 바꾸지 않았다면 (되돌린 수정 등) 저장된 요약을 재사용
+    // 새로고침으로 요청했으면 같은 입력이라도 새로 생성하고 completeSummary 에서 덮어씀
+    job->inputHash = summaryInputHash(*job);
+    QString reused = job->forceRefresh ? QString()
+                                       : DataManager::instance().getSummaryByInputHash(job->inputHash);
+    if(!reused.isEmpty()) {
+        qDebug() << "Summary inputs unchanged for" << job->date << "- reusing stored text";
+        AIMetrics::instance().increment("summary.content_hits");
+        if(job->combined) {
+            // 운세만 따로 생성
+            endFlight(QString("fortune:%1:%2").arg(job->userId).arg(job->date), job->generation);
+            requestTodaysFortune(job->userId, false, QDate::fromString(job->date, "yyyy-MM-dd"));
         }
+        completeSummary(job, reused);
+        return;
+    }
+
+    // 네트워크 없이 바로 만들 수 있는 로컬 요약을 날씨까지 넣어 전달 (LLM 결과가 오면 교체됨)
+    emit dailySummaryDraft(job->userId, job->date, localSummary(*job));
+
+    if(job->combined) {
+        finishCombinedJob(job);
+        return;
     }
 
-    // 7. AI 프롬프트 작성 (이름 포함)
+    // 5. AI 프롬프트 작성 (이름 포함)
     QString prompt = QString(
                          "당신은 친근한 일정 관리 비서입니다.\n\n"
                          "사용자 이름: %1\n"
                          "날짜: %2\n"
                          "날씨: %3\n"
                          "일정:\n%4\n\n"
-                         "다음 형식으로 일정 요약을 작성해주세요:\n\n"
-                         "📅 %2\n\n"
-                         "🌦️ [날씨 정보를 자연스럽게 표현]\n\n"
-                         "━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"
-                         "✨ AI 추천:\n"
-                         "[%1님의 일정을 분석하여 친근하게 요약하고, 날씨를 고려한 실용적인 조언 제공]\n\n"
-                         "📌 준비물: [필요한 준비물]\n\n"
-                         "따뜻하고 친근한 톤으로 작성하되, 사용자 이름을 자연스럽게 사용해주세요."
-                         ).arg(userName, todayKorean, weatherInfo, schedulesText);
+                         ).arg(job->userName, job->dateKorean, job->weather.text(), job->schedulesText)
+                     + summaryFormat(*job);
 
-    // 8. OpenAI API 호출
-    QString summary = callOpenAI(prompt);
+    // 6. OpenAI API 호출 - 스트리밍이면 토큰이 도착하는 대로 dailySummaryPartial 로 전달
+    auto onDelta = [this, job](const QString &delta) {
+        emit dailySummaryPartial(job->userId, job->date, delta);
+    };
+    callOpenAI(prompt, [this, job](const QString &result) {
+        completeSummary(job, result);
+    }, onDelta);
+}
 
-    if(summary.isEmpty()) {
-        summary = QString(
-                      "📅 %1\n\n"
-                      "🌦️ %2\n\n"
-                      "━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"
-                      "✨ %3님의 오늘 일정:\n%4\n\n"
-                      "좋은 하루 보내세요! 😊"
-                      ).arg(todayKorean, weatherInfo, userName, schedulesText);
-    }
+void AIService::finishCombinedJob(const std::shared_ptr<SummaryJob> &job){
+    // 공통 정보는 한 번만 보내고, 두 항목의 형식을 각각 지정해서 JSON 으로 받음
+    QString prompt = QString(
+                         "당신은 친근한 일정 관리 비서이자 따뜻한 운세 상담사입니다.\n\n"
+                         "사용자 이름: %1\n"
+                         "날짜: %2\n"
+                         "생년월일: %3 (만 %4세)\n"
+                         "날씨: %5\n"
+                         "일정:\n%6\n\n"
+                         "아래 두 항목을 작성해서 {\"summary\": \"...\", \"fortune\": \"...\"} 형태의 JSON 객체 하나로만 답해주세요.\n\n"
+                         "[summary]\n"
+                         ).arg(job->userName, job->dateKorean, job->fortune.birth, job->fortune.age,
+                              job->weather.text(), job->schedulesText)
+                     + summaryFormat(*job)
+                     + "\n\n[fortune]\n"
+                     + fortuneFormat(job->fortune);
+
+    QString fortuneKey = QString("fortune:%1:%2").arg(job->userId).arg(job->date);
+    callOpenAI(prompt, [this, job, fortuneKey](const QString &result) {
+        if(job->generation != m_generation) {
+            return;
+        }
+        // 전송 실패(시간 초과, 재시도 소진, 차단기 열림)면 개별 호출도 같은 곳에서 실패하므로
+        // 다시 요청하지 않고 요약은 로컬 요약으로, 운세는 기본 문구로 끝냄 (운세는 저장하지 않음)
+        if(result.isEmpty()) {
+            qWarning() << "Combined request failed, using local summary";
+            AIMetrics::instance().increment("combined.failures");
+            endFlight(fortuneKey, job->generation);
+            emit todaysFortuneReady(job->userId, job->date, fortuneFallback(job->fortune));
+            completeSummary(job, QString());
+            return;
+        }
 
-    // 9. DB에 저장
-    DataManager::instance().saveDailySummary(userId, today, summary, weatherInfo);
+        QJsonObject obj = QJsonDocument::fromJson(result.toUtf8()).object();
+        QString summary = obj["summary"].toString().trimmed();
+        QString fortune = obj["fortune"].toString().trimmed();
 
-    return summary;
+        // 응답은 왔지만 형식이 맞지 않으면 기존 개별 호출로 다시 시도
+        if(summary.isEmpty() || fortune.isEmpty()) {
+            qWarning() << "Combined response invalid, falling back to separate requests";
+            AIMetrics::instance().increment("combined.fallbacks");
+            endFlight(job->flightKey, job->generation);
+            endFlight(fortuneKey, job->generation);
+            QDate date = QDate::fromString(job->date, "yyyy-MM-dd");
+            requestTodaysFortune(job->userId, false, date);
+            requestDailySummary(job->userId, false, date);
+            return;
+        }
+
+        endFlight(fortuneKey, job->generation);
+        DataManager::instance().saveDailyFortune(job->userId, job->date, fortune);
+        emit todaysFortuneReady(job->userId, job->date, fortune);
+
+        completeSummary(job, summary);
+    }, nullptr, true);
 }
 
-QString AIService::generateTodaysFortune(int userId){
-    // 1. 사용자 정보 가져오기
+void AIService::requestWeekSummaries(int userId, int days){
+    AIMetrics::instance().increment("week.requests");
+
     QVariantMap userInfo = DataManager::instance().getUserInfo(userId);
-    QString userName = userInfo["name"].toString();
-    QString userBirth = userInfo["dateOfBirth"].toString();
+    QDate today = QDate::currentDate();
 
-    // 2. 오늘 날짜
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
-    QString todayKorean = QDate::currentDate().toString("M월 d일 dddd");
+    // 이미 요약이 있거나 생성 중인 날짜는 제외
+    QList<std::shared_ptr<SummaryJob>> jobs;
+    for(int i = 0; i < days; ++i) {
+        QDate date = today.addDays(i);
+        auto job = std::make_shared<SummaryJob>();
+        job->userId = userId;
+        job->date = date.toString("yyyy-MM-dd");
+        job->dateKorean = date.toString("M월 d일 dddd");
+        job->dayLabel = (date == today) ? "오늘" : "이날";
+        job->prefetch = true;
+
+        if(!DataManager::instance().getCachedSummary(userId, job->date).isEmpty()) {
+            continue;
+        }
+        job->flightKey = QString("summary:%1:%2").arg(userId).arg(job->date);
+        if(m_inflight.contains(job->flightKey)) {
+            continue;
+        }
+        m_inflight.insert(job->flightKey, m_generation);
+        job->generation = m_generation;
+
+        job->userName = userInfo["name"].toString();
+        job->schedules = DataManager::instance().getSchedulesByDate(userId, job->date);
+        job->schedulesText = buildSchedulesText(job->schedules, job->dayLabel);
+        job->schedulesReady = true;
+        jobs.append(job);
+    }
+
+    if(jobs.isEmpty()) {
+        qDebug() << "Week summaries already cached for user" << userId;
+        return;
+    }
 
-    // 3. 생년월일 파싱 (나이, 띠 등 계산 가능)
-    QDate birthDate = QDate::fromString(userBirth, "yyyy-MM-dd");
-    int age = QDate::currentDate().year() - birthDate.year();
+    // 예보 한 번으로 모든 날짜의 날씨를 채움
+    RegionLocation location = RegionResolver::resolve(userInfo["address"].toString());
+    getForecast(location, [this, jobs](const QList<DayForecast> &forecast) {
+        if(jobs.first()->generation != m_generation) {
+            qDebug() << "Dropping cancelled week summary jobs";
+            return;
+        }
+        QList<std::shared_ptr<SummaryJob>> pending;
+        for(const auto &job : jobs) {
+            for(const DayForecast &day : forecast) {
+                if(day.date.toString("yyyy-MM-dd") == job->date) {
+                    job->weather = day.toWeatherInfo();
+                    break;
+                }
+            }
+            job->weatherReady = true;
 
-    // 4. AI 프롬프트 작성 (이름과 생년월일 포함)
+            job->inputHash = summaryInputHash(*job);
+            QString reused = job->forceRefresh ? QString()
+                                               : DataManager::instance().getSummaryByInputHash(job->inputHash);
+            if(!reused.isEmpty()) {
+                AIMetrics::instance().increment("summary.content_hits");
+                completeSummary(job, reused);
+            } else if(job->schedules.isEmpty()) {
+                // 일정이 없는 날은 LLM 에 보낼 내용이 없으므로 로컬 요약으로 충분
+                AIMetrics::instance().increment("week.local_days");
+                completeSummary(job, localSummary(*job));
+            } else {
+                pending.append(job);
+            }
+        }
+
+        // 한 번의 호출에 너무 많은 날짜가 들어가지 않도록 나눠서 동시에 요청
+        for(int i = 0; i < pending.size(); i += m_weekBatchSize) {
+            requestWeekBatch(pending.mid(i, m_weekBatchSize));
+        }
+    });
+}
+
+void AIService::requestWeekBatch(const QList<std::shared_ptr<SummaryJob>> &jobs){
+    AIMetrics::instance().increment("week.batches");
+    AIMetrics::instance().increment("week.batched_days", jobs.size());
+
+    QString daysText;
+    for(const auto &job : jobs) {
+        daysText += QString("[%1] %2\n날씨: %3\n일정:\n%4\n\n")
+                        .arg(job->date, job->dateKorean, job->weather.text(), job->schedulesText);
+    }
+
+    SummaryJob formatJob = *jobs.first();
+    formatJob.dateKorean = "[해당 날짜]";
+    QString prompt = QString(
+                         "당신은 친근한 일정 관리 비서입니다.\n\n"
+                         "사용자 이름: %1\n\n"
+                         "%3"
+                         "위 %2일 각각에 대해 요약을 작성해서 "
+                         "{\"days\": [{\"date\": \"yyyy-MM-dd\", \"summary\": \"...\"}]} 형태의 JSON 객체 하나로만 답해주세요.\n\n"
+                         ).arg(formatJob.userName, QString::number(jobs.size()), daysText)
+                     + summaryFormat(formatJob);
+
+    // 하루치 요약 분량 x 날짜 수
+    int maxTokens = 500 * jobs.size();
+    callOpenAI(prompt, [this, jobs](const QString &result) {
+        QHash<QString, QString> summaries;
+        const QJsonArray days = QJsonDocument::fromJson(result.toUtf8()).object()["days"].toArray();
+        for(const QJsonValue &value : days) {
+            QJsonObject day = value.toObject();
+            summaries.insert(day["date"].toString(), day["summary"].toString().trimmed());
+        }
+        if(summaries.isEmpty()) {
+            qWarning() << "Week batch response invalid, using local summaries";
+        }
+
+        // 응답에서 빠진 날짜는 completeSummary 가 로컬 요약으로 채우되 저장하지 않음 (다음에 다시 생성)
+        for(const auto &job : jobs) {
+            completeSummary(job, summaries.value(job->date));
+        }
+    }, nullptr, true, maxTokens);
+}
+
+void AIService::completeSummary(const std::shared_ptr<SummaryJob> &job, const QString &result){
+    // cancelAll 이후에 끝난 작업은 저장/전달하지 않음 (키도 새 세대의 작업이 가지고 있을 수 있음)
+    if(job->generation != m_generation) {
+        return;
+    }
+    QString summary = result;
+
+    if(!summary.isEmpty() && !job->inputHash.isEmpty()) {
+        DataManager::instance().saveSummaryByInputHash(job->inputHash, summary);
+    } else if(summary.isEmpty()) {
+        // API 키가 없거나 호출이 실패하면 로컬 요약을 그대로 사용
+        AIMetrics::instance().increment("summary.local_fallbacks");
+        summary = localSummary(*job);
+
+        // 미리 생성은 백그라운드 최적화일 뿐이므로 대체 요약을 저장하지 않음
+        // (저장하면 완료된 날짜로 보여서 그 날의 LLM 요약이 다시 만들어지지 않음)
+        if(job->prefetch) {
+            endFlight(job->flightKey, job->generation);
+            emit dailySummaryReady(job->userId, job->date, summary);
+            return;
+        }
+    }
+
+    // 7. 스트림이 끝난 뒤 완성된 텍스트를 DB에 저장
+    DataManager::instance().saveDailySummary(job->userId, job->date, summary, job->weather.text());
+    endFlight(job->flightKey, job->generation);
+
+    emit dailySummaryReady(job->userId, job->date, summary);
+}
+
+QString AIService::localSummary(const SummaryJob &job) const{
+    LocalSummarizer::Input input;
+    input.userName = job.userName;
+    input.dateKorean = job.dateKorean;
+    input.dayLabel = job.dayLabel;
+    input.weatherValid = job.weather.valid;
+    input.weatherText = job.weather.text();
+    input.weatherDescription = job.weather.description;
+    input.temperature = job.weather.temperature;
+    input.schedules = job.schedules;
+    return LocalSummarizer::summarize(input);
+}
+
+QString AIService::summaryFormat(const SummaryJob &job) const{
+    return QString(
+               "다음 형식으로 일정 요약을 작성해주세요:\n\n"
+               "📅 %2\n\n"
+               "🌦️ [날씨 정보를 자연스럽게 표현]\n\n"
+               "━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"
+               "✨ AI 추천:\n"
+               "[%1님의 일정을 분석하여 친근하게 요약하고, 날씨를 고려한 실용적인 조언 제공]\n\n"
+               "📌 준비물: [필요한 준비물]\n\n"
+               "따뜻하고 친근한 톤으로 작성하되, 사용자 이름을 자연스럽게 사용해주세요."
+               ).arg(job.userName, job.dateKorean);
+}
+
+QString AIService::summaryInputHash(const SummaryJob &job) const{
+    // 날씨는 그대로 넣으면 매번 달라지므로 설명 + 5°C 단위 구간으로 묶음
+    QString weatherBucket = job.weather.valid
+        ? QString("%1|%2").arg(job.weather.description).arg(qRound(job.weather.temperature / 5.0) * 5)
+        : QString("unknown");
+
+    QStringList inputs = {
+        QString::number(job.userId), job.userName,
+        job.date, job.dayLabel,
+        weatherBucket,
+        job.schedulesText
+    };
+
+    QByteArray digest = QCryptographicHash::hash(inputs.join('\x1f').toUtf8(), QCryptographicHash::Sha256);
+    return QString::fromLatin1(digest.toHex());
+}
+
+QString AIService::buildSchedulesText(const QList<QVariantMap> &schedules, const QString &dayLabel) const{
+    // 일정이 많거나 메모가 길어도 프롬프트 크기가 예산을 넘지 않도록 압축
+    return PromptBudget::compactSchedules(schedules, dayLabel, m_scheduleTokenBudget);
+}
+
+AIService::FortuneProfile AIService::fortuneProfile(const QVariantMap &userInfo, const QDate &date) const{
+    FortuneProfile profile;
+    profile.userName = userInfo["name"].toString();
+    profile.birth = userInfo["dateOfBirth"].toString();
+    profile.dayKorean = date.toString("M월 d일 dddd");
+
+    // 생년월일 파싱 (나이, 띠 등 계산 가능)
+    QDate birthDate = QDate::fromString(profile.birth, "yyyy-MM-dd");
+    profile.age = QString::number(date.year() - birthDate.year());
+    return profile;
+}
+
+QString AIService::fortuneFormat(const FortuneProfile &profile) const{
+    return QString(
+               "다음 형식으로 이 날짜의 운세를 작성해주세요:\n\n"
+               "🔮 %2 %1님의 운세\n"
+               "생년월일: %3 (만 %4세)\n\n"
+               "전체운: [전체운 내용 - 2-3문장, 긍정적이면서도 현실적인 조언]\n\n"
+               "금전운: [금전운 내용 - 1-2문장]\n\n"
+               "연애운: [연애운 내용 - 1-2문장]\n\n"
+               "건강운: [건강운 내용 - 1-2문장]\n\n"
+               "💡 오늘의 조언: [구체적이고 실용적인 한마디]\n\n"
+               "따뜻하고 긍정적인 톤으로, %1님을 자연스럽게 호칭하며 작성해주세요."
+               ).arg(profile.userName, profile.dayKorean, profile.birth, profile.age);
+}
+
+QString AIService::fortuneFallback(const FortuneProfile &profile) const{
+    return QString(
+               "🔮 %2 %1님의 운세\n"
+               "생년월일: %3 (만 %4세)\n\n"
+               "전체운: 오늘은 평온한 하루가 될 것입니다. 계획한 일들을 차근차근 진행해보세요.\n\n"
+               "금전운: 안정적인 흐름입니다. 충동적인 지출만 조심하세요.\n\n"
+               "연애운: 솔직한 대화가 좋은 결과를 가져옵니다.\n\n"
+               "건강운: 컨디션 관리에 신경 쓰는 것이 좋습니다.\n\n"
+               "💡 오늘의 조언: 작은 것부터 차근차근 실천하세요!"
+               ).arg(profile.userName, profile.dayKorean, profile.birth, profile.age);
+}
+
+void AIService::requestTodaysFortune(int userId, bool forceRefresh, const QDate &date){
+    AIMetrics::instance().increment("fortune.requests");
+    QString day = date.toString("yyyy-MM-dd");
+
+    // 하루 한 번만 생성 - 캐시가 있으면 인덱스 조회 한 번으로 끝
+    // forceRefresh 여도 기존 운세는 지우지 않음 - 새 운세가 생성되면 그 자리에 덮어씀
+    if(!forceRefresh) {
+        QString cached = DataManager::instance().getCachedFortune(userId, day);
+        AIMetrics::instance().increment(cached.isEmpty() ? "fortune.cache_misses" : "fortune.cache_hits");
+        if(!cached.isEmpty()) {
+            qDebug() << "Using cached fortune for" << day;
+            QTimer::singleShot(0, this, [this, userId, day, cached]() {
+                emit todaysFortuneReady(userId, day, cached);
+            });
+            return;
+        }
+    }
+
+    // 진행 중인 같은 요청이 있으면 합류
+    QString flightKey = QString("fortune:%1:%2").arg(userId).arg(day);
+    if(!beginFlight(flightKey, "fortune")) {
+        return;
+    }
+    int generation = m_generation;
+
+    // 1. 사용자 정보 가져오기
+    FortuneProfile profile = fortuneProfile(DataManager::instance().getUserInfo(userId), date);
+
+    // 2. AI 프롬프트 작성 (이름과 생년월일 포함)
     QString prompt = QString(
                          "당신은 친절하고 따뜻한 운세 상담사입니다.\n\n"
                          "사용자 이름: %1\n"
-                         "오늘 날짜: %2\n"
-                         "생년월일: %3 (만 %4세)\n\n"
-                         "다음 형식으로 오늘의 운세를 작성해주세요:\n\n"
-                         "🔮 %2 %1님의 운세\n"
+                         "날짜: %2\n"
                          "생년월일: %3 (만 %4세)\n\n"
-                         "전체운: [전체운 내용 - 2-3문장, 긍정적이면서도 현실적인 조언]\n\n"
-                         "금전운: [금전운 내용 - 1-2문장]\n\n"
-                         "연애운: [연애운 내용 - 1-2문장]\n\n"
-                         "건강운: [건강운 내용 - 1-2문장]\n\n"
-                         "💡 오늘의 조언: [구체적이고 실용적인 한마디]\n\n"
-                         "따뜻하고 긍정적인 톤으로, %1님을 자연스럽게 호칭하며 작성해주세요."
-                         ).arg(userName, todayKorean, userBirth, QString::number(age));
+                         ).arg(profile.userName, profile.dayKorean, profile.birth, profile.age)
+                     + fortuneFormat(profile);
 
-    // 5. OpenAI API 호출
-    QString fortune = callOpenAI(prompt);
+    // 3. OpenAI API 호출 - 스트리밍이면 토큰이 도착하는 대로 todaysFortunePartial 로 전달
+    auto onDelta = [this, userId, day](const QString &delta) {
+        emit todaysFortunePartial(userId, day, delta);
+    };
+    callOpenAI(prompt, [this, flightKey, generation, userId, day, profile](const QString &result) {
+        if(generation != m_generation) {
+            return;
+        }
+        QString fortune = result;
+        endFlight(flightKey, generation);
 
-    if(fortune.isEmpty()) {
-        fortune = QString(
-                      "🔮 %2 %1님의 운세\n"
-                      "생년월일: %3 (만 %4세)\n\n"
-                      "전체운: 오늘은 평온한 하루가 될 것입니다. 계획한 일들을 차근차근 진행해보세요.\n\n"
-                      "금전운: 안정적인 흐름입니다. 충동적인 지출만 조심하세요.\n\n"
-                      "연애운: 솔직한 대화가 좋은 결과를 가져옵니다.\n\n"
-                      "건강운: 컨디션 관리에 신경 쓰는 것이 좋습니다.\n\n"
-                      "💡 오늘의 조언: 작은 것부터 차근차근 실천하세요!"
-                      ).arg(userName, todayKorean, userBirth, QString::number(age));
-    }
+        // 4. DB에 저장 (기본 문구는 다음 요청 때 다시 시도하도록 저장하지 않음)
+        // 새로고침이 실패하면 저장되어 있던 운세를 그대로 다시 전달
+        if(!fortune.isEmpty()) {
+            DataManager::instance().saveDailyFortune(userId, day, fortune);
+        } else {
+            fortune = DataManager::instance().getCachedFortune(userId, day);
+        }
+        if(fortune.isEmpty()) {
+            fortune = fortuneFallback(profile);
+        }
 
-    return fortune;
+        emit todaysFortuneReady(userId, day, fortune);
+    }, onDelta);
 }
 
-QString AIService::parseLocationFromAddress(const QString &address){
-    qDebug() << "address: " << address;
-    if(address.isEmpty()) {
-        return "Seoul";
-    }
+//헬퍼 함수
+// 호출 하나를 여러 엔드포인트가 경쟁하는 경주로 관리
+struct AIService::LlmRace {
+    std::function<void(const QString &)> callback;
+    std::function<void(const QString &)> onDelta;
+    QByteArray prompt;
+    bool stream = false;
+    bool jsonMode = false;
+    int maxTokens = 1000;
+    QString requestClass;                       // 지연 히스토그램 키 접미사 - 출력 분량이 다른 요청끼리 p95 를 섞지 않음
+
+    QList<int> order;                           // 지연 순으로 정렬한 후보 엔드포인트
+    int started = 0;                            // 지금까지 출발시킨 후보 수
+    int pending = 0;                            // 아직 끝나지 않은 시도 수
+    bool done = false;
+    int owner = -1;                             // 스트림 조각을 처음 보낸 시도 (나머지는 취소)
+    QList<QPointer<QNetworkReply>> replies;     // 시도별 현재 reply (취소용)
+};
+
+void AIService::callOpenAI(const QString &prompt, std::function<void(const QString &)> callback,
+                           std::function<void(const QString &)> onDelta, bool jsonMode, int maxTokens){
+    auto race = std::make_shared<LlmRace>();
+    race->callback = callback;
+    race->onDelta = onDelta;
+    race->prompt = prompt.toUtf8();
+    // JSON 모드는 완성된 객체를 한 번에 파싱해야 하므로 스트리밍하지 않음
+    race->stream = m_streamEnabled && onDelta && !jsonMode;
+    race->jsonMode = jsonMode;
+    race->maxTokens = maxTokens > 0 ? maxTokens : (jsonMode ? 2000 : 1000);   // 결합 응답은 두 항목 분량
+    race->requestClass = QString(".%1%2").arg(jsonMode ? "json" : "text").arg(race->maxTokens);
+    race->order = rankLlmEndpoints();
 
-    // 주소 파싱 로직
-    // 예: "서울특별시 강남구 테헤란로" -> "Seoul" 또는 "Gangnam,Seoul"
-    // 예: "경기도 성남시 분당구" -> "Seongnam"
+    // 로그아웃 시 취소할 수 있도록 진행 중인 호출 목록에 등록
+    m_activeRaces.removeIf([](const std::weak_ptr<LlmRace> &weak) { return weak.expired(); });
+    m_activeRaces.append(race);
 
-    QStringList parts = address.split(" ");
-    if(parts.isEmpty()) {
-        return "Seoul";
+    if(race->order.isEmpty()) {
+        qWarning() << "No LLM endpoint configured!";
+        QTimer::singleShot(0, this, [callback]() { callback(QString()); });
+        return;
     }
 
-    QString firstPart = parts[0];
+    // 추정치와 실제 usage 를 비교할 수 있도록 함께 기록
+    AIMetrics::instance().increment("openai.prompt_tokens_estimated", PromptBudget::estimateTokens(prompt));
 
-    // 시/도 단위로 매핑
-    if(firstPart.contains("서울")) return "Seoul";
-    if(firstPart.contains("부산")) return "Busan";
-    if(firstPart.contains("인천")) return "Incheon";
-    if(firstPart.contains("대구")) return "Daegu";
-    if(firstPart.contains("대전")) return "Daejeon";
-    if(firstPart.contains("광주")) return "Gwangju";
-    if(firstPart.contains("울산")) return "Ulsan";
-    if(firstPart.contains("세종")) return "Sejong";
+    launchNextLlmAttempt(race);
 
-    return "Seoul";  // 기본값
+    // 1순위가 같은 종류 요청의 평소 p95 안에 답하지 않으면 2순위에도 같은 요청을 보내고 먼저 온 답을 사용
+    qint64 hedgeDelay = hedgeDelayMs(*race);
+    if(race->order.size() > 1 && hedgeDelay > 0) {
+        QTimer::singleShot(int(hedgeDelay), this, [this, race]() {
+            if(race->done || race->owner != -1 || race->started > 1) {
+                return;
+            }
+            qDebug() << "LLM hedge: primary slower than p95, sending backup request";
+            AIMetrics::instance().increment("llm.hedged");
+            launchNextLlmAttempt(race);
+        });
+    }
 }
 
-//헬퍼 함수
-QString AIService::callOpenAI(const QString &prompt){
-    if(openai_apikey.isEmpty()) {
-        qWarning() << "OpenAI API key is not set!";
-        return QString();
+void AIService::launchNextLlmAttempt(const std::shared_ptr<LlmRace> &race){
+    if(race->started >= race->order.size()) {
+        return;
     }
+    int slot = race->started++;
+    race->pending++;
+    race->replies.append(nullptr);
 
-    QString urlString = "https://api.openai.com/v1/chat/completions";
-    QUrl url(urlString);
-    QNetworkRequest request(url);
+    const LlmEndpoint &endpoint = m_llmEndpoints[race->order[slot]];
+    bool stream = race->stream;
+
+    QNetworkRequest request(endpoint.url);
 
     // 헤더 설정
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("Authorization", QString("Bearer %1").arg(openai_apikey).toUtf8());
+    if(!endpoint.apiKey.isEmpty()) {
+        request.setRawHeader("Authorization", QString("Bearer %1").arg(endpoint.apiKey).toUtf8());
+    }
+    if(stream) {
+        request.setRawHeader("Accept", "text/event-stream");
+    }
 
     // JSON 요청 본문 작성
     QJsonObject json;
-    json["model"] = "gpt-4o-mini";
+    json["model"] = endpoint.model;
     json["temperature"] = 0.7;
-    json["max_tokens"] = 1000;
+    json["max_tokens"] = race->maxTokens;
+    json["stream"] = stream;
+    if(stream) {
+        // 마지막 청크에 usage 를 포함시켜 스트리밍에서도 토큰 사용량을 기록
+        QJsonObject streamOptions;
+        streamOptions["include_usage"] = true;
+        json["stream_options"] = streamOptions;
+    }
+    if(race->jsonMode) {
+        QJsonObject responseFormat;
+        responseFormat["type"] = "json_object";
+        json["response_format"] = responseFormat;
+    }
 
     QJsonArray messages;
     QJsonObject message;
     message["role"] = "user";
-    message["content"] = prompt;
+    message["content"] = QString::fromUtf8(race->prompt);
     messages.append(message);
     json["messages"] = messages;
 
-    QJsonDocument doc(json);
-    QByteArray data = doc.toJson();
+    QByteArray data = QJsonDocument(json).toJson();
+
+    // 시도별 상태 - 스트리밍 파서와 지금까지 받은 텍스트
+    struct AttemptState {
+        SseParser parser;
+        QString accumulated;
+        QElapsedTimer sinceStart;
+        bool firstByte = false;
+    };
+    auto state = std::make_shared<AttemptState>();
+    QString name = endpoint.name;
+
+    // 이긴 시도 외의 나머지는 취소 (차단기/재시도에 실패로 잡히지 않도록 표시 후 abort)
+    auto cancelOthers = [race, slot]() {
+        for(int i = 0; i < race->replies.size(); ++i) {
+            QNetworkReply *other = race->replies[i];
+            if(i != slot && other) {
+                other->setProperty("cancelled", true);
+                other->abort();
+            }
+        }
+    };
+
+    auto handleEvents = [race, slot, state, cancelOthers](const QList<QByteArray> &events) {
+        for(const QByteArray &event : events) {
+            if(event == "[DONE]") {
+                continue;
+            }
+            QJsonObject chunk = QJsonDocument::fromJson(event).object();
+            QJsonArray choices = chunk["choices"].toArray();
+            if(choices.isEmpty()) {
+                recordUsage(chunk["usage"].toObject());   // include_usage 의 마지막 청크
+                continue;
+            }
+            QString delta = choices[0].toObject()["delta"].toObject()["content"].toString();
+            if(delta.isEmpty()) {
+                continue;
+            }
+            // 처음 조각을 보낸 시도가 스트림을 차지하고 나머지는 취소
+            if(race->owner == -1) {
+                race->owner = slot;
+                cancelOthers();
+            }
+            if(race->owner != slot || race->done) {
+                return;
+            }
+            state->accumulated.append(delta);
+            race->onDelta(delta);
+        }
+    };
+
+    // 재시도할 때마다 새 reply 로 시작 (재시도는 아직 화면에 아무것도 보내지 않았을 때만)
+    auto onStarted = [this, race, slot, state, name, stream, handleEvents](QNetworkReply *reply) {
+        race->replies[slot] = reply;
+        state->parser = SseParser();
+        state->sinceStart.start();
+        state->firstByte = false;
+        if(!stream) {
+            return;
+        }
+        connect(reply, &QNetworkReply::readyRead, this, [reply, state, name, handleEvents]() {
+            if(!state->firstByte) {
+                // 스트림은 전체 시간보다 첫 응답까지의 시간이 헤지 기준으로 적절
+                state->firstByte = true;
+                AIMetrics::instance().recordLatency(name + ".ttfb", state->sinceStart.elapsed());
+            }
+            handleEvents(state->parser.feed(reply->readAll()));
+        });
+    };
+    auto canRetry = [race, state]() {
+        return !race->done && race->owner == -1 && state->accumulated.isEmpty();
+    };
+
+    sendRequest(name, request, data, [this, race, slot, state, name, stream, handleEvents, cancelOthers](QNetworkReply *reply) {
+        if(race->done) {
+            return;
+        }
+
+        QString result;
+        if(reply && reply->error() == QNetworkReply::NoError) {
+            if(stream) {
+                handleEvents(state->parser.feed(reply->readAll()));
+                handleEvents(state->parser.finish());
+                result = state->accumulated.trimmed();
+            } else {
+                QJsonObject responseObj = QJsonDocument::fromJson(reply->readAll()).object();
+                recordUsage(responseObj["usage"].toObject());
 
-    // 동기 방식으로 요청 전송
-    QEventLoop loop;
-    QNetworkReply* reply = m_networkManager->post(request, data);
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
+                QJsonArray choices = responseObj["choices"].toArray();
+                if(!choices.isEmpty()) {
+                    result = choices[0].toObject()["message"].toObject()["content"].toString().trimmed();
+                }
+            }
+        } else if(reply) {
+            // 중간에 끊긴 스트림은 실패로 처리 (호출 측에서 기본 문구로 교체)
+            qWarning() << "LLM API Error (" << name << "):" << reply->errorString();
+        }
 
-    QString result;
+        // 헤지 기준은 같은 종류(JSON 여부, 토큰 한도) 요청끼리만 비교 - 스트림은 첫 응답 시간으로 따로 기록
+        if(!stream && !result.isEmpty()) {
+            AIMetrics::instance().recordLatency(name + race->requestClass, state->sinceStart.elapsed());
+        }
 
-    if(reply->error() == QNetworkReply::NoError) {
-        QByteArray response = reply->readAll();
-        QJsonDocument responseDoc = QJsonDocument::fromJson(response);
-        QJsonObject responseObj = responseDoc.object();
+        race->pending--;
+        // 스트림을 차지한 시도가 실패하면 이미 화면에 일부가 나갔으므로 다른 시도를 기다리지 않음
+        bool ownerFailed = stream && race->owner == slot && result.isEmpty();
 
-        if(responseObj.contains("choices")) {
-            QJsonArray choices = responseObj["choices"].toArray();
-            if(!choices.isEmpty()) {
-                QJsonObject choice = choices[0].toObject();
-                QJsonObject messageObj = choice["message"].toObject();
-                result = messageObj["content"].toString().trimmed();
+        if(!result.isEmpty() || ownerFailed) {
+            race->done = true;
+            if(slot > 0 && !result.isEmpty()) {
+                AIMetrics::instance().increment("llm.hedge_wins");
             }
+            cancelOthers();
+            race->callback(result);
+            return;
         }
-    } else {
-        qWarning() << "OpenAI API Error:" << reply->errorString();
-        qWarning() << "Response:" << reply->readAll();
+
+        // 실패: 아직 출발하지 않은 후보가 있으면 바로 넘김, 모두 실패하면 기본 문구
+        if(race->started < race->order.size()) {
+            AIMetrics::instance().increment("llm.failovers");
+            launchNextLlmAttempt(race);
+        } else if(race->pending == 0) {
+            race->done = true;
+            race->callback(QString());
+        }
+    }, onStarted, canRetry);
+}
+
+QList<int> AIService::rankLlmEndpoints() const{
+    // 차단된 엔드포인트는 제외 (모두 차단이면 그대로 두어 차단기가 기본 문구로 처리)
+    QList<int> order;
+    for(int i = 0; i < m_llmEndpoints.size(); ++i) {
+        if(m_endpoints.value(m_llmEndpoints[i].name).breaker.state() != CircuitBreaker::Open) {
+            order.append(i);
+        }
+    }
+    if(order.isEmpty()) {
+        for(int i = 0; i < m_llmEndpoints.size(); ++i) {
+            order.append(i);
+        }
+    }
+
+    // 표본이 충분한 엔드포인트는 p50 지연 순, 표본이 적은 엔드포인트는 먼저 시도해서 측정
+    auto score = [this](int index) -> qint64 {
+        LatencyHistogram histogram = AIMetrics::instance().histogram(m_llmEndpoints[index].name);
+        return histogram.count() < kMinRoutingSamples ? 0 : histogram.percentile(0.5);
+    };
+    std::stable_sort(order.begin(), order.end(), [&score](int a, int b) { return score(a) < score(b); });
+    return order;
+}
+
+qint64 AIService::hedgeDelayMs(const LlmRace &race) const{
+    // 엔드포인트 전체 p95 는 짧은 요약 호출이 대부분이라 결합 JSON/주간 일괄 호출은 거의 항상 넘겨 매번 중복 전송됨
+    // 같은 종류 요청의 표본이 충분히 쌓이기 전에는 헤지하지 않음 (드문 일괄 호출은 사실상 헤지 없음)
+    QString name = m_llmEndpoints[race.order.first()].name;
+    LatencyHistogram histogram = AIMetrics::instance().histogram(race.stream ? name + ".ttfb" : name + race.requestClass);
+    if(histogram.count() < kMinHedgeSamples) {
+        return -1;   // 기준이 될 p95 가 아직 없음
+    }
+    return qMax<qint64>(m_hedgeMinMs, histogram.percentile(0.95));
+}
+
+void AIService::warmUpConnections(){
+    if(!m_prewarmEnabled) {
+        return;
+    }
+
+    for(auto it = m_endpoints.begin(); it != m_endpoints.end(); ++it) {
+        if(it->host.isEmpty()) {
+            continue;
+        }
+        // 연결만 맺어 두면 이후 같은 호스트로 가는 요청이 이 연결을 재사용
+        // 로그아웃 후 다시 로그인하면 그 사이 연결이 닫혔을 수 있으므로 다시 맺고 첫 요청도 새로 측정
+        qDebug() << "Pre-connecting to" << it->host;
+        if(it->encrypted) {
+            m_networkManager->connectToHostEncrypted(it->host, it->port);
+        } else {
+            m_networkManager->connectToHost(it->host, it->port);
+        }
+        it->warmedUp = true;
+        it->firstCallSetupMs = -1;
+    }
+}
+
+void AIService::recordConnectionSetup(const QString &endpoint, qint64 handshakeMs, qint64 setupMs){
+    EndpointPolicy &policy = m_endpoints[endpoint];
+
+    // 새 연결의 핸드셰이크 비용 - 응답 생성 시간과 무관하게 연결 준비에 든 시간만 잼
+    // 미리 연결하면 핸드셰이크가 거의 없으므로 실행 사이에 평균을 누적해 둠
+    if(handshakeMs >= 0) {
+        AIMetrics::instance().recordLatency(endpoint + ".handshake", handshakeMs);
+
+        QSettings settings("DailyFlow", "Metrics");
+        QString prefix = endpoint + "/handshake";
+        int samples = settings.value(prefix + "_samples", 0).toInt();
+        double average = settings.value(prefix + "_avgMs", 0.0).toDouble();
+        average += (handshakeMs - average) / (samples + 1);
+        settings.setValue(prefix + "_samples", samples + 1);
+        settings.setValue(prefix + "_avgMs", average);
+    }
+
+    // 미리 연결한 뒤 첫 요청이 실제로 기다린 연결 준비 시간
+    if(policy.warmedUp && policy.firstCallSetupMs < 0) {
+        policy.firstCallSetupMs = setupMs;
+    }
+}
+
+bool AIService::isRetryable(QNetworkReply *reply) const{
+    // 서버 쪽 일시 오류(408, 429, 5xx)와 연결/시간 초과만 재시도 - 401 같은 요청 오류는 바로 실패
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if(status == 408 || status == 429 || status >= 500) {
+        return true;
+    }
+    if(status != 0) {
+        return false;
+    }
+
+    switch(reply->error()) {
+    case QNetworkReply::OperationCanceledError:   // setTransferTimeout 초과
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void AIService::sendRequest(const QString &endpoint, QNetworkRequest request, const QByteArray &body,
+                            ReplyHandler onFinished, ReplyHandler onStarted,
+                            std::function<bool()> canRetry, int attempt){
+    EndpointPolicy &policy = m_endpoints[endpoint];
+
+    // 차단 중이면 네트워크를 기다리지 않고 바로 실패 전달 (호출 측 기본 문구 사용)
+    if(!policy.breaker.allowRequest()) {
+        AIMetrics::instance().increment(endpoint + ".short_circuited");
+        qWarning() << "Circuit open, skipping" << endpoint << "request";
+        QTimer::singleShot(0, this, [onFinished]() { onFinished(nullptr); });
+        return;
+    }
+    bool probe = policy.breaker.probeInFlight();
+
+    // 데이터가 timeoutMs 동안 오가지 않으면 OperationCanceledError 로 끝남
+    request.setTransferTimeout(policy.timeoutMs);
+    // HTTP/2 를 지원하면 한 연결에서 요청을 다중화해서 재사용
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+    AIMetrics::instance().increment(endpoint + ".calls");
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    QNetworkReply *reply = body.isNull() ? m_networkManager->get(request)
+                                         : m_networkManager->post(request, body);
+    if(onStarted) {
+        onStarted(reply);
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    // 새 연결을 맺었다면(socketStartedConnecting) 요청이 전송될 때까지가 핸드셰이크
+    auto connectStartedMs = std::make_shared<qint64>(-1);
+    connect(reply, &QNetworkReply::socketStartedConnecting, this, [connectStartedMs, elapsed]() {
+        *connectStartedMs = elapsed.elapsed();
+    });
+    connect(reply, &QNetworkReply::requestSent, this, [this, endpoint, connectStartedMs, elapsed]() {
+        qint64 sentMs = elapsed.elapsed();
+        recordConnectionSetup(endpoint, *connectStartedMs >= 0 ? sentMs - *connectStartedMs : -1, sentMs);
+    }, Qt::SingleShotConnection);
+#endif
+
+    connect(reply, &QNetworkReply::finished, this,
+            [this, endpoint, request, body, onFinished, onStarted, canRetry, attempt, reply, elapsed, probe]() {
+        // 헤지 경쟁에서 진 요청이나 cancelAll 로 중단된 요청은 실패가 아니므로 지표/차단기에 반영하지 않음
+        // 다만 HalfOpen 의 시험 요청이었다면 다음 시험을 보낼 수 있도록 풀어 줌
+        if(reply->property("cancelled").toBool()) {
+            if(probe) {
+                m_endpoints[endpoint].breaker.releaseProbe();
+            }
+            reply->deleteLater();
+            return;
+        }
+
+        EndpointPolicy &policy = m_endpoints[endpoint];
+        AIMetrics::instance().recordLatency(endpoint, elapsed.elapsed());
+
+        if(reply->error() == QNetworkReply::NoError) {
+            policy.breaker.recordSuccess();
+            onFinished(reply);
+            reply->deleteLater();
+            return;
+        }
+
+        policy.breaker.recordFailure();
+        AIMetrics::instance().increment(endpoint + ".failures");
+        if(reply->error() == QNetworkReply::OperationCanceledError) {
+            AIMetrics::instance().increment(endpoint + ".timeouts");
+        }
+
+        bool retry = attempt < policy.maxRetries && isRetryable(reply) && (!canRetry || canRetry());
+        if(!retry) {
+            onFinished(reply);
+            reply->deleteLater();
+            return;
+        }
+
+        // 지수 백오프 + 지터: base * 2^attempt 의 50~150%
+        int delay = policy.backoffBaseMs * (1 << attempt);
+        delay = delay / 2 + QRandomGenerator::global()->bounded(delay);
+        qWarning() << endpoint << "request failed:" << reply->errorString()
+                   << "- retry" << (attempt + 1) << "in" << delay << "ms";
+        AIMetrics::instance().increment(endpoint + ".retries");
+        reply->deleteLater();
+
+        QTimer::singleShot(delay, this, [this, endpoint, request, body, onFinished, onStarted, canRetry, attempt]() {
+            // 기다리는 동안 더 이상 필요 없어졌으면 (다른 엔드포인트가 먼저 답함) 보내지 않음
+            if(canRetry && !canRetry()) {
+                onFinished(nullptr);
+                return;
+            }
+            sendRequest(endpoint, request, body, onFinished, onStarted, canRetry, attempt + 1);
+        });
+    });
+}
+
+QList<QVariantMap> AIService::endpointStatus() const{
+    QList<QVariantMap> rows;
+    for(auto it = m_endpoints.constBegin(); it != m_endpoints.constEnd(); ++it) {
+        const QString &name = it.key();
+        qint64 count = AIMetrics::instance().value(name + ".latency.count");
+
+        QVariantMap row;
+        row["endpoint"] = name;
+        row["state"] = it->breaker.stateName();
+        row["consecutiveFailures"] = it->breaker.consecutiveFailures();
+        row["calls"] = AIMetrics::instance().value(name + ".calls");
+        row["failures"] = AIMetrics::instance().value(name + ".failures");
+        row["retries"] = AIMetrics::instance().value(name + ".retries");
+        row["avgLatencyMs"] = count > 0 ? AIMetrics::instance().value(name + ".latency.total_ms") / count : 0;
+        row["maxLatencyMs"] = AIMetrics::instance().value(name + ".latency.max_ms");
+        LatencyHistogram histogram = AIMetrics::instance().histogram(name);
+        row["p50LatencyMs"] = histogram.percentile(0.5);
+        row["p95LatencyMs"] = histogram.percentile(0.95);
+
+        // 미리 연결로 줄어든 첫 요청 지연 = 새 연결 핸드셰이크 평균 - 미리 연결 후 첫 요청의 연결 준비 시간
+        QSettings settings("DailyFlow", "Metrics");
+        if(settings.contains(name + "/handshake_avgMs")) {
+            qint64 handshakeMs = qRound64(settings.value(name + "/handshake_avgMs").toDouble());
+            row["handshakeMs"] = handshakeMs;
+            if(it->warmedUp && it->firstCallSetupMs >= 0) {
+                row["handshakeSavingsMs"] = qMax<qint64>(0, handshakeMs - it->firstCallSetupMs);
+            }
+        }
+        rows.append(row);
     }
+    return rows;
+}
 
-    reply->deleteLater();
-    return result;
+QStringList AIService::llmEndpointNames() const{
+    QStringList names;
+    for(const LlmEndpoint &endpoint : m_llmEndpoints) {
+        names.append(endpoint.name);
+    }
+    return names;
 }
 
-QString AIService::getWeather(const QString &location){
+void AIService::getWeather(const RegionLocation &location, WeatherCallback callback){
+    // 캐시 키는 "시도|시군구" (같은 지역의 사용자는 같은 항목을 공유)
+    const QString &key = location.key;
+
+    WeatherInfo cached;
+    if(lookupWeatherCache(key, &cached)) {
+        QTimer::singleShot(0, this, [callback, cached]() { callback(cached); });
+        return;
+    }
+
     if(weather_apikey.isEmpty()) {
         qWarning() << "Weather API key is not set!";
-        return "날씨 정보를 가져올 수 없습니다.";
+        QTimer::singleShot(0, this, [callback]() { callback(WeatherInfo()); });
+        return;
     }
 
-    qDebug() << "Fetching weather for location:" << location;
+    // 같은 지역의 요청이 진행 중이면 콜백만 등록하고 응답을 공유
+    AIMetrics::instance().increment("weather.requests");
+    auto waiting = m_weatherWaiters.find(key);
+    if(waiting != m_weatherWaiters.end()) {
+        waiting->append(callback);
+        AIMetrics::instance().increment("weather.deduplicated");
+        qDebug() << "Weather request coalesced:" << key;
+        return;
+    }
+    m_weatherWaiters.insert(key, QList<WeatherCallback>{callback});
 
-    // OpenWeatherMap API URL 구성
-    QString urlString = QString("https://api.openweathermap.org/data/2.5/weather?q=%1&appid=%2&units=metric&lang=kr")
-                            .arg(location, weather_apikey);
+    qDebug() << "Fetching weather for location:" << key << location.latitude << location.longitude;
+
+    // OpenWeatherMap API URL 구성 (도시 이름 대신 좌표로 조회)
+    QString urlString = QString("%1/weather?lat=%2&lon=%3&appid=%4&units=metric&lang=kr")
+                            .arg(m_weatherBaseUrl)
+                            .arg(location.latitude, 0, 'f', 4)
+                            .arg(location.longitude, 0, 'f', 4)
+                            .arg(weather_apikey);
 
     QUrl url(urlString);
     QNetworkRequest request(url);
 
-    // 동기 방식으로 요청 전송
-    QEventLoop loop;
-    QNetworkReply* reply = m_networkManager->get(request);
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-    loop.exec();
+    // 비동기로 요청 전송 - 응답은 finished 시그널에서 처리 (본문이 없으면 GET)
+    sendRequest("weather", request, QByteArray(), [this, key](QNetworkReply *reply) {
+        WeatherInfo weather;
+
+        if(reply && reply->error() == QNetworkReply::NoError) {
+            QByteArray response = reply->readAll();
+            QJsonDocument doc = QJsonDocument::fromJson(response);
+            QJsonObject obj = doc.object();
+
+            if(obj.contains("main") && obj.contains("weather")) {
+                QJsonObject main = obj["main"].toObject();
+                QJsonArray weatherArray = obj["weather"].toArray();
+
+                weather.temperature = main["temp"].toDouble();
+                weather.humidity = main["humidity"].toInt();
+
+                weather.description = "맑음";
+                if(!weatherArray.isEmpty()) {
+                    QJsonObject weatherObj = weatherArray[0].toObject();
+                    weather.description = weatherObj["description"].toString();
+                }
+                weather.valid = true;
+
+                qDebug() << "Weather info created:" << weather.text();
+                storeWeatherCache(key, weather, weatherExpiry(reply, m_weatherTtlSeconds));
+            } else {
+                qDebug() << "JSON structure invalid. Full response:" << doc.toJson();
+            }
+        } else if(reply) {
+            qWarning() << "Weather API Error:" << reply->errorString();
+        }
+
+        // 기다리던 모든 호출자에게 같은 결과 전달
+        const QList<WeatherCallback> waiters = m_weatherWaiters.take(key);
+        for(const auto &waiter : waiters) {
+            waiter(weather);
+        }
+    });
+}
+
+void AIService::requestForecast(int userId){
+    QVariantMap userInfo = DataManager::instance().getUserInfo(userId);
+    RegionLocation location = RegionResolver::resolve(userInfo["address"].toString());
+
+    getForecast(location, [this, userId](const QList<DayForecast> &days) {
+        emit forecastReady(userId, days);
+    });
+}
+
+void AIService::getForecast(const RegionLocation &location, ForecastCallback callback){
+    const QString &key = location.key;
+
+    auto it = m_forecastCache.constFind(key);
+    if(it != m_forecastCache.constEnd() && it->expiresAt > QDateTime::currentDateTimeUtc()) {
+        QList<DayForecast> days = it->days;
+        QTimer::singleShot(0, this, [callback, days]() { callback(days); });
+        return;
+    }
+
+    if(weather_apikey.isEmpty()) {
+        QTimer::singleShot(0, this, [callback]() { callback(QList<DayForecast>()); });
+        return;
+    }
+
+    // 같은 지역의 예보 요청이 진행 중이면 합류
+    AIMetrics::instance().increment("forecast.requests");
+    auto waiting = m_forecastWaiters.find(key);
+    if(waiting != m_forecastWaiters.end()) {
+        waiting->append(callback);
+        AIMetrics::instance().increment("forecast.deduplicated");
+        return;
+    }
+    m_forecastWaiters.insert(key, QList<ForecastCallback>{callback});
+
+    // 5일치 3시간 간격 예보를 한 번에 받아 날짜별로 묶음 (날짜마다 따로 요청하지 않음)
+    QString urlString = QString("%1/forecast?lat=%2&lon=%3&appid=%4&units=metric&lang=kr")
+                            .arg(m_weatherBaseUrl)
+                            .arg(location.latitude, 0, 'f', 4)
+                            .arg(location.longitude, 0, 'f', 4)
+                            .arg(weather_apikey);
+    QNetworkRequest request{QUrl(urlString)};
+
+    sendRequest("weather", request, QByteArray(), [this, key](QNetworkReply *reply) {
+        QList<DayForecast> days;
+
+        if(reply && reply->error() == QNetworkReply::NoError) {
+            days = parseForecast(QJsonDocument::fromJson(reply->readAll()).object());
+            if(!days.isEmpty()) {
+                m_forecastCache.insert(key, ForecastCacheEntry{days, weatherExpiry(reply, m_forecastTtlSeconds)});
+            }
+        } else if(reply) {
+            qWarning() << "Forecast API Error:" << reply->errorString();
+        }
 
-    QString weatherInfo = "날씨 정보를 가져올 수 없습니다.";
+        const QList<ForecastCallback> waiters = m_forecastWaiters.take(key);
+        for(const auto &waiter : waiters) {
+            waiter(days);
+        }
+    });
+}
 
-    if(reply->error() == QNetworkReply::NoError) {
-        QByteArray response = reply->readAll();
-        QJsonDocument doc = QJsonDocument::fromJson(response);
-        QJsonObject obj = doc.object();
+QList<DayForecast> AIService::parseForecast(const QJsonObject &obj) const{
+    QMap<QDate, DayForecast> byDate;
+    QMap<QDate, int> middayDistance;   // 한낮(12시)에 가장 가까운 예보를 대표값으로
 
-        if(obj.contains("main") && obj.contains("weather")) {
-            QJsonObject main = obj["main"].toObject();
-            QJsonArray weather = obj["weather"].toArray();
+    const QJsonArray list = obj["list"].toArray();
+    for(const QJsonValue &value : list) {
+        QJsonObject entry = value.toObject();
+        QDateTime time = QDateTime::fromSecsSinceEpoch(entry["dt"].toInteger());
+        QDate date = time.date();
+        QJsonObject main = entry["main"].toObject();
+        double temp = main["temp"].toDouble();
+        int pop = qRound(entry["pop"].toDouble() * 100);
 
-            double temp = main["temp"].toDouble();
-            int humidity = main["humidity"].toInt();
+        auto it = byDate.find(date);
+        if(it == byDate.end()) {
+            DayForecast day;
+            day.date = date;
+            day.minTemp = temp;
+            day.maxTemp = temp;
+            it = byDate.insert(date, day);
+            middayDistance.insert(date, INT_MAX);
+        }
+        it->minTemp = qMin(it->minTemp, temp);
+        it->maxTemp = qMax(it->maxTemp, temp);
+        it->precipitationChance = qMax(it->precipitationChance, pop);
 
-            QString description = "맑음";
+        int distance = qAbs(time.time().hour() - 12);
+        if(distance < middayDistance[date]) {
+            middayDistance[date] = distance;
+            it->temperature = temp;
+            it->humidity = main["humidity"].toInt();
+            QJsonArray weather = entry["weather"].toArray();
             if(!weather.isEmpty()) {
-                QJsonObject weatherObj = weather[0].toObject();
-                description = weatherObj["description"].toString();
+                it->description = weather[0].toObject()["description"].toString();
             }
+        }
+    }
+
+    return byDate.values();
+}
 
-            // 수정된 부분: arg를 올바르게 사용
-            weatherInfo = QString("%1, 기온 %2°C, 습도 %3%")
-                              .arg(description)
-                              .arg(temp, 0, 'f', 1)  // 소수점 1자리
-                              .arg(humidity);
+bool AIService::beginFlight(const QString &key, const QString &kind){
+    if(m_inflight.contains(key)) {
+        AIMetrics::instance().increment(kind + ".deduplicated");
+        qDebug() << "Request coalesced with in-flight" << key;
+        return false;
+    }
+    m_inflight.insert(key, m_generation);
+    return true;
+}
 
-            qDebug() << "Weather info created:" << weatherInfo;
+void AIService::endFlight(const QString &key, int generation){
+    auto it = m_inflight.find(key);
+    if(it != m_inflight.end() && it.value() == generation) {
+        m_inflight.erase(it);
+    }
+}
+
+void AIService::cancelAll(){
+    int cancelled = 0;
+    for(const std::weak_ptr<LlmRace> &weak : m_activeRaces) {
+        std::shared_ptr<LlmRace> race = weak.lock();
+        if(!race || race->done) {
+            continue;
+        }
+        // 콜백을 부르지 않고 끝냄 - 실패로 보고 기본 문구를 저장하는 일이 없도록
+        race->done = true;
+        for(QNetworkReply *reply : race->replies) {
+            if(reply) {
+                reply->setProperty("cancelled", true);
+                reply->abort();
+            }
+        }
+        cancelled++;
+    }
+    m_activeRaces.clear();
+
+    // 날씨/예보를 기다리는 요약 작업은 세대를 올려서 다음 단계에서 버려지게 함
+    // 이전 세대가 가진 single-flight 키를 지워야 다음 요청이 끝나지 않을 작업에 합류하지 않음
+    int cancelledGeneration = m_generation++;
+    for(auto it = m_inflight.begin(); it != m_inflight.end();) {
+        if(it.value() <= cancelledGeneration) {
+            it = m_inflight.erase(it);
         } else {
-            qDebug() << "JSON structure invalid. Full response:" << doc.toJson();
+            ++it;
         }
-    } else {
-        qWarning() << "Weather API Error:" << reply->errorString();
     }
 
-    reply->deleteLater();
-    return weatherInfo;
+    if(cancelled > 0) {
+        qDebug() << "Cancelled" << cancelled << "in-flight LLM calls";
+        AIMetrics::instance().increment("llm.cancelled", cancelled);
+    }
+}
+
+void AIService::flushUsage(){
+    QMap<QString, qint64> deltas = AIMetrics::instance().takePending();
+    if(deltas.isEmpty()) {
+        return;
+    }
+    if(!DataManager::instance().addUsageCounters(QDate::currentDate().toString("yyyy-MM-dd"), deltas)) {
+        qWarning() << "Failed to save AI usage rollup," << deltas.size() << "counters dropped";
+    }
+}
+
+bool AIService::hasPendingRequests() const{
+    return !m_inflight.isEmpty() || !m_weatherWaiters.isEmpty() || !m_forecastWaiters.isEmpty();
+}
+
+QMap<QString, qint64> AIService::requestStats() const{
+    return AIMetrics::instance().counters();
+}
+
+bool AIService::lookupWeatherCache(const QString &location, WeatherInfo *info){
+    QDateTime now = QDateTime::currentDateTimeUtc();
+
+    // 1. 메모리
+    auto it = m_weatherCache.constFind(location);
+    if(it != m_weatherCache.constEnd() && it->expiresAt > now) {
+        qDebug() << "Weather cache hit (memory):" << location;
+        AIMetrics::instance().increment("weather.cache_hits");
+        *info = it->info;
+        return true;
+    }
+
+    // 2. weather_cache 테이블 (재시작 후나 다른 사용자가 받아둔 값)
+    QVariantMap row = DataManager::instance().getCachedWeather(location);
+    if(!row.isEmpty()) {
+        WeatherCacheEntry entry;
+        entry.info.valid = true;
+        entry.info.description = row["description"].toString();
+        entry.info.temperature = row["temperature"].toDouble();
+        entry.info.humidity = row["humidity"].toInt();
+        entry.expiresAt = row["expiresAt"].toDateTime();
+        m_weatherCache.insert(location, entry);
+
+        qDebug() << "Weather cache hit (db):" << location;
+        AIMetrics::instance().increment("weather.cache_hits");
+        *info = entry.info;
+        return true;
+    }
+
+    AIMetrics::instance().increment("weather.cache_misses");
+    return false;
+}
+
+void AIService::storeWeatherCache(const QString &location, const WeatherInfo &info, const QDateTime &expiresAt){
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    if(!info.valid || expiresAt <= now) {
+        return;  // 실패 응답이나 no-store 응답은 저장하지 않음
+    }
+
+    m_weatherCache.insert(location, WeatherCacheEntry{info, expiresAt});
+    DataManager::instance().saveCachedWeather(location, info.description, info.temperature,
+                                              info.humidity, now, expiresAt);
+}
+
+QDateTime AIService::weatherExpiry(QNetworkReply *reply, int ttlSeconds) const{
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    QDateTime expiry = now.addSecs(ttlSeconds);
+
+    // 설정한 TTL이 상한이고, 서버가 더 짧은 수명을 알려주면 그 값을 따름
+    QString cacheControl = QString::fromLatin1(reply->rawHeader("Cache-Control")).toLower();
+    if(cacheControl.contains("no-store") || cacheControl.contains("no-cache")) {
+        return now;
+    }
+
+    static const QRegularExpression maxAgePattern("max-age\\s*=\\s*(\\d+)");
+    QRegularExpressionMatch match = maxAgePattern.match(cacheControl);
+    if(match.hasMatch()) {
+        qint64 age = QString::fromLatin1(reply->rawHeader("Age")).toLongLong();
+        return qMin(expiry, now.addSecs(match.captured(1).toLongLong() - age));
+    }
+
+    QDateTime expires = QDateTime::fromString(QString::fromLatin1(reply->rawHeader("Expires")), Qt::RFC2822Date);
+    if(expires.isValid()) {
+        return qMin(expiry, expires.toUTC());
+    }
+
+    return expiry;
 }
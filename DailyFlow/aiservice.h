@@ -2,8 +2,51 @@
 #define AISERVICE_H
 
 #include <QObject>
+#include <QMetaType>
 #include <QString>
+#include <QStringList>
+#include <QList>
+#include <QVariantMap>
 #include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QDate>
+#include <QDateTime>
+#include <QHash>
+#include <QMap>
+#include <functional>
+#include <memory>
+#include "circuitbreaker.h"
+#include "regionresolver.h"
+#include "llmendpoint.h"
+
+class QNetworkReply;
+class QTimer;
+class QJsonObject;
+
+// 날씨 조회 결과
+struct WeatherInfo {
+    bool valid = false;
+    QString description;
+    double temperature = 0.0;
+    int humidity = 0;
+
+    QString text() const;   // 프롬프트와 화면에 쓰는 문장
+};
+
+// 예보의 하루 요약 (3시간 간격 예보를 날짜별로 묶은 것)
+struct DayForecast {
+    QDate date;
+    QString description;     // 한낮에 가장 가까운 예보의 설명
+    double temperature = 0.0;   // 한낮 기온
+    int humidity = 0;
+    double minTemp = 0.0;
+    double maxTemp = 0.0;
+    int precipitationChance = 0;   // 하루 중 최대 강수 확률 (%)
+
+    WeatherInfo toWeatherInfo() const;
+    QString shortText() const;     // "맑음 12~21°C" (+ 강수 확률)
+};
+Q_DECLARE_METATYPE(DayForecast)
 
 class AIService : public QObject
 {
@@ -12,8 +55,55 @@ class AIService : public QObject
 public:
     static AIService& instance();
 
-    QString generateDailySummary(int userId);
-    QString generateTodaysFortune(int userId);
+    // 비동기 요청 - 결과는 아래 시그널로 전달됨 (호출 즉시 반환)
+    // date 를 주면 그 날짜용으로 생성 (다음 날 미리 생성용)
+    void requestDailySummary(int userId, bool forceRefresh = false,    // forceRefresh: 같은 입력의 저장된 요약도 쓰지 않고 새로 생성
+                             const QDate &date = QDate::currentDate());
+    void requestTodaysFortune(int userId, bool forceRefresh = false,   // forceRefresh: 캐시 무시하고 새로 생성
+                              const QDate &date = QDate::currentDate());
+
+    // 진행 중인 요청이 있는지 (백그라운드 미리 생성은 한가할 때만)
+    bool hasPendingRequests() const;
+
+    // 홈 화면용: 둘 다 캐시에 없으면 한 번의 호출로 함께 생성, 아니면 개별 요청을 동시에 출발
+    void requestHomeContent(int userId);
+
+    // 오늘부터 days 일치 요약을 한꺼번에 생성해서 schedule_summaries 에 저장
+    // (이미 있는 날짜는 건너뛰고, 남은 날짜는 JSON 배치 호출 하나 또는 몇 개로 생성)
+    void requestWeekSummaries(int userId, int days = 7);
+
+    // 요청/중복 제거 카운터 (예: "summary.requests", "summary.deduplicated")
+    QMap<QString, qint64> requestStats() const;
+
+    // 사용자 지역의 며칠치 예보 - 지역별로 한 번 받아 캐시하고 forecastReady 로 전달
+    void requestForecast(int userId);
+
+    // 로그인 화면이 떠 있는 동안 API 서버에 미리 TLS 연결 (DNS/TCP/TLS 비용을 첫 요청에서 제거)
+    void warmUpConnections();
+
+    // 외부 API별 차단기 상태와 지연 통계 (endpoint, state, calls, failures, retries, avgLatencyMs ...)
+    QList<QVariantMap> endpointStatus() const;
+    QStringList llmEndpointNames() const;   // LLM_ENDPOINTS 순서의 LLM 엔드포인트 이름 (카운터 접두사)
+
+    // 진행 중인 LLM 호출을 모두 중단 (로그아웃 시) - 결과 시그널은 오지 않고 캐시에도 저장되지 않음
+    // 날씨/예보 요청은 지역 단위로 공유되는 캐시를 채우므로 그대로 둠
+    void cancelAll();
+
+    // 지금까지 쌓인 사용량 카운터를 오늘 날짜의 일별 집계에 더함 (1분마다, 종료 시 자동 호출)
+    void flushUsage();
+
+signals:
+    void dailySummaryReady(int userId, const QString &date, const QString &summary);
+    void todaysFortuneReady(int userId, const QString &date, const QString &fortune);
+
+    // 스트리밍 중 새로 도착한 텍스트 조각 (완료 시에는 위의 Ready 시그널로 전체 텍스트 전달)
+    void dailySummaryPartial(int userId, const QString &date, const QString &delta);
+
+    // 로컬 규칙으로 바로 만든 요약 - LLM 응답이 오기 전까지 먼저 보여줄 내용
+    void dailySummaryDraft(int userId, const QString &date, const QString &draft);
+    void todaysFortunePartial(int userId, const QString &date, const QString &delta);
+
+    void forecastReady(int userId, const QList<DayForecast> &days);
 
 private:
     AIService();
@@ -21,14 +111,141 @@ private:
     AIService(const AIService&) = delete;
     AIService& operator=(const AIService&) = delete;
 
-    QString openai_apikey;
     QString weather_apikey;
+    QString m_weatherBaseUrl;                 // WEATHER_BASE_URL
 
     QNetworkAccessManager* m_networkManager;  // 멤버 변수로 추가
+    bool m_streamEnabled;                     // OPENAI_STREAM
+    bool m_combinedEnabled;                   // AI_COMBINED_MODE
+    bool m_prewarmEnabled;                    // AI_PREWARM
+    int m_scheduleTokenBudget;                // PROMPT_SCHEDULE_TOKEN_BUDGET
+    QTimer *m_usageFlushTimer;
+
+    // 운세 프롬프트에 들어가는 사용자 정보
+    struct FortuneProfile {
+        QString userName;
+        QString dayKorean;
+        QString birth;
+        QString age;
+    };
+    FortuneProfile fortuneProfile(const QVariantMap &userInfo, const QDate &date) const;
+    QString fortuneFormat(const FortuneProfile &profile) const;
+    QString fortuneFallback(const FortuneProfile &profile) const;   // 생성 실패 시 기본 문구 (저장하지 않음)
+
+    // 요약 생성 과정의 의존 관계
+    //   사용자 정보 ─┬─ 날씨(HTTP) ──┬─ 프롬프트 → OpenAI → 저장
+    //               └─ 오늘 일정(DB) ┘
+    // 날씨와 일정이 모두 준비되면 다음 단계로 진행
+    struct SummaryJob {
+        QString flightKey;
+        int userId = 0;
+        QString date;
+        QString dateKorean;
+        QString dayLabel;   // "오늘" 또는 "이날"
+        QString userName;
+        WeatherInfo weather;
+        QList<QVariantMap> schedules;
+        QString schedulesText;
+        bool weatherReady = false;
+        bool schedulesReady = false;
+        bool combined = false;      // 운세까지 한 번의 JSON 응답으로 생성
+        FortuneProfile fortune;     // combined 일 때만 사용
+        QString inputHash;          // summary_content_cache 키
+        bool forceRefresh = false;  // 새로고침 버튼 - summary_content_cache 를 건너뛰고 덮어씀
+        bool prefetch = false;      // 일주일치 미리 생성 - 실패 시 로컬 요약을 저장하지 않음
+        int generation = 0;         // 시작할 때의 m_generation - cancelAll 이후면 버려짐
+    };
+    void startSummaryInputs(const std::shared_ptr<SummaryJob> &job, const QString &userAddress);
+    void advanceSummaryJob(const std::shared_ptr<SummaryJob> &job);
+    void completeSummary(const std::shared_ptr<SummaryJob> &job, const QString &result);
+    QString summaryFormat(const SummaryJob &job) const;
+    QString localSummary(const SummaryJob &job) const;   // 규칙 기반 요약 (네트워크 없음)
+    QString summaryInputHash(const SummaryJob &job) const;
+
+    // 요약 + 운세 결합 요청 (실패하면 개별 요청으로 대체)
+    void requestCombinedContent(int userId, const QDate &date);
+    void finishCombinedJob(const std::shared_ptr<SummaryJob> &job);
+    void requestWeekBatch(const QList<std::shared_ptr<SummaryJob>> &jobs);
+    int m_weekBatchSize;                      // WEEK_SUMMARY_BATCH_DAYS
+    QString buildSchedulesText(const QList<QVariantMap> &schedules, const QString &dayLabel) const;
+
+    // 응답이 오면 callback 호출 (실패 시 OpenAI는 빈 문자열, 날씨는 valid == false)
+    // onDelta 를 주면 스트리밍("stream": true)으로 요청하고 토큰 조각마다 호출
+    // jsonMode 면 response_format json_object 로 요청 (스트리밍하지 않음), maxTokens 0 이면 기본값
+    void callOpenAI(const QString &prompt, std::function<void(const QString &)> callback,
+                    std::function<void(const QString &)> onDelta = nullptr, bool jsonMode = false,
+                    int maxTokens = 0);
+
+    // LLM 엔드포인트 (LLM_ENDPOINTS) - 지연 히스토그램으로 순위를 매기고
+    // 1순위가 p95 안에 답하지 않으면 2순위에 헤지 요청, 실패하면 다음 순위로 넘김
+    struct LlmRace;
+    QList<std::weak_ptr<LlmRace>> m_activeRaces;   // cancelAll 용
+    QList<LlmEndpoint> m_llmEndpoints;
+    int m_hedgeMinMs;
+    static const int kMinRoutingSamples = 5;   // 이보다 적으면 지연 순위에 쓰지 않음
+    static const int kMinHedgeSamples = 20;    // 이보다 적으면 p95 를 믿지 않고 헤지하지 않음
+    void launchNextLlmAttempt(const std::shared_ptr<LlmRace> &race);
+    QList<int> rankLlmEndpoints() const;
+    qint64 hedgeDelayMs(const LlmRace &race) const;
+
+    // 외부 API 호출 공통 경로: 시간 제한 → 실패 시 지터 포함 지수 백오프 재시도 → 차단기
+    // onFinished 에는 마지막 응답이 전달되고, 차단 중이면 nullptr 이 전달됨 (reply 는 이후 자동 삭제)
+    // onStarted 는 시도마다 새 reply 가 만들어질 때 호출, canRetry 가 false 면 재시도하지 않음
+    struct EndpointPolicy {
+        QString host;                 // 미리 연결할 호스트
+        bool encrypted = true;
+        quint16 port = 443;
+        bool warmedUp = false;        // warmUpConnections 로 연결해 두었는지 (다시 호출되면 새로 측정)
+        qint64 firstCallSetupMs = -1; // 미리 연결 후 첫 요청이 전송되기까지 걸린 시간
+        int timeoutMs = 10000;
+        int maxRetries = 2;
+        int backoffBaseMs = 500;
+        CircuitBreaker breaker;
+    };
+    QMap<QString, EndpointPolicy> m_endpoints;   // LLM 엔드포인트 이름들 ("openai" 등), "weather"
+    using ReplyHandler = std::function<void(QNetworkReply *)>;
+    void sendRequest(const QString &endpoint, QNetworkRequest request, const QByteArray &body,
+                     ReplyHandler onFinished, ReplyHandler onStarted = nullptr,
+                     std::function<bool()> canRetry = nullptr, int attempt = 0);
+    bool isRetryable(QNetworkReply *reply) const;
+    // 요청 시작 → 요청 전송까지의 연결 준비 시간 기록
+    // handshakeMs 는 새 연결을 맺은 경우 연결 시작 → 전송 (DNS 이후 TCP/TLS), 기존 연결 재사용이면 -1
+    void recordConnectionSetup(const QString &endpoint, qint64 handshakeMs, qint64 setupMs);
+
+    using WeatherCallback = std::function<void(const WeatherInfo &)>;
+    void getWeather(const RegionLocation &location, WeatherCallback callback);
+
+    // 예보: 날짜별 묶음을 지역 단위로 캐시, 진행 중인 요청은 공유
+    using ForecastCallback = std::function<void(const QList<DayForecast> &)>;
+    void getForecast(const RegionLocation &location, ForecastCallback callback);
+    QList<DayForecast> parseForecast(const QJsonObject &obj) const;
+    struct ForecastCacheEntry {
+        QList<DayForecast> days;
+        QDateTime expiresAt;
+    };
+    QHash<QString, ForecastCacheEntry> m_forecastCache;
+    QHash<QString, QList<ForecastCallback>> m_forecastWaiters;
+    int m_forecastTtlSeconds;
+
+    // 날씨 캐시: 메모리 → weather_cache 테이블 → OpenWeatherMap 순으로 조회
+    struct WeatherCacheEntry {
+        WeatherInfo info;
+        QDateTime expiresAt;
+    };
+    QHash<QString, WeatherCacheEntry> m_weatherCache;
+
+    // single-flight: 진행 중인 동일 요청은 네트워크 호출 하나를 공유
+    // "summary:<userId>:<date>", "fortune:<userId>:<date>" → 키를 가진 작업의 세대
+    QHash<QString, int> m_inflight;
+    int m_generation = 0;       // cancelAll 마다 증가 - 이전 세대의 작업은 결과를 저장/전달하지 않음
+    QHash<QString, QList<WeatherCallback>> m_weatherWaiters;  // 지역별 대기 콜백
+    bool beginFlight(const QString &key, const QString &kind);   // 이미 진행 중이면 false
+    void endFlight(const QString &key, int generation);          // 그 세대가 가진 키일 때만 제거
+    int m_weatherTtlSeconds;
 
-    QString callOpenAI(const QString &prompt);
-    QString getWeather(const QString &loc);
-    QString parseLocationFromAddress(const QString &address);
+    bool lookupWeatherCache(const QString &location, WeatherInfo *info);
+    void storeWeatherCache(const QString &location, const WeatherInfo &info, const QDateTime &expiresAt);
+    QDateTime weatherExpiry(QNetworkReply *reply, int ttlSeconds) const;
 };
 
 #endif // AISERVICE_H
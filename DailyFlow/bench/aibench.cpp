@@ -0,0 +1,274 @@
+// AIService 벤치마크 - MockApiServer 를 상대로 홈 화면 콘텐츠(요약 + 운세) 생성 시간을 측정
+//
+//   dailyflow_bench [--users N] [--rounds N] [--separate]
+//
+// 1. 지연: 사용자 한 명씩 순서대로 요청해서 로컬 초안/첫 조각/완료까지의 시간 분포
+//    (결합 모드의 JSON 응답은 스트리밍하지 않으므로 첫 조각은 --separate 일 때만 측정됨)
+// 2. 처리량: N명이 동시에 요청했을 때 전체 소요 시간과 초당 처리 수
+// 3. 저하된 상위 서버: 오류 30%, 느린 응답, 무응답 각각에서의 지연과 로컬 대체 횟수
+
+#include "mockapiserver.h"
+#include "../aiservice.h"
+#include "../aimetrics.h"
+#include "../datamanager.h"
+#include "../envloader.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDate>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+
+namespace {
+
+QTextStream &out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+struct Stats {
+    QList<qint64> samples;
+
+    qint64 percentile(double p) const
+    {
+        if (samples.isEmpty()) {
+            return -1;
+        }
+        QList<qint64> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        int index = qBound(0, int(p * sorted.size() + 0.5) - 1, int(sorted.size()) - 1);
+        return sorted[index];
+    }
+
+    QString text() const
+    {
+        return QString("n=%1 p50=%2ms p95=%3ms max=%4ms")
+            .arg(samples.size()).arg(percentile(0.5)).arg(percentile(0.95)).arg(percentile(1.0));
+    }
+};
+
+// 벤치마크용 사용자 (주소는 지역 해석이 되도록 실제 시/군/구)
+QList<int> createUsers(int count)
+{
+    static const char *addresses[] = {"서울특별시 강남구", "부산광역시 해운대구", "대전광역시 유성구", "경기도 수원시"};
+    QList<int> userIds;
+    DataManager &dm = DataManager::instance();
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    for (int i = 0; i < count; ++i) {
+        QString username = QString("bench%1").arg(i);
+        if (!dm.userExists(username)) {
+            dm.addUser(username, "bench", QString("사용자%1").arg(i), username + "@example.com",
+                       "1990-01-01", QString::fromUtf8(addresses[i % 4]));
+        }
+        int userId = dm.loginUser(username, "bench");
+        dm.addSchedule(userId, "팀 회의", today, "10:00", "11:00", "회의실", "주간 보고", "회의");
+        dm.addSchedule(userId, "점심 약속", today, "12:30", "13:30", "강남역", "", "약속");
+        dm.addSchedule(userId, "운동", today, "19:00", "20:00", "헬스장", "", "개인");
+        userIds.append(userId);
+    }
+    return userIds;
+}
+
+// 캐시를 비우고 입력(일정)도 바꿔서 요약 내용 캐시까지 피함
+void invalidate(const QList<int> &userIds, int round)
+{
+    DataManager &dm = DataManager::instance();
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    for (int userId : userIds) {
+        dm.addSchedule(userId, QString("벤치 일정 %1").arg(round), today, "16:00", "16:30", "", "", "업무");
+        dm.invalidateSummary(userId, today);
+        dm.invalidateFortune(userId, today);
+    }
+}
+
+// 사용자들의 홈 화면 콘텐츠를 동시에 요청하고 요약과 운세가 모두 도착할 때까지 대기
+// 사용자별 완료/첫 조각/로컬 초안 시간을 기록, 전체 소요 시간 반환
+qint64 runHomeContent(const QList<int> &userIds, Stats *done, Stats *firstChunk, Stats *draft = nullptr,
+                      int timeoutMs = 60000)
+{
+    AIService &ai = AIService::instance();
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    QSet<int> summaryPending(userIds.begin(), userIds.end());
+    QSet<int> fortunePending = summaryPending;
+    QSet<int> firstSeen;
+    QSet<int> draftSeen;
+    QEventLoop loop;
+    QElapsedTimer elapsed;
+
+    auto finishIfDone = [&](int userId) {
+        if (!summaryPending.contains(userId) && !fortunePending.contains(userId)) {
+            done->samples.append(elapsed.elapsed());
+        }
+        if (summaryPending.isEmpty() && fortunePending.isEmpty()) {
+            loop.quit();
+        }
+    };
+
+    QList<QMetaObject::Connection> connections;
+    connections << QObject::connect(&ai, &AIService::dailySummaryPartial,
+                                    [&](int userId, const QString &date, const QString &) {
+        if (date == today && summaryPending.contains(userId) && !firstSeen.contains(userId)) {
+            firstSeen.insert(userId);
+            firstChunk->samples.append(elapsed.elapsed());
+        }
+    });
+    connections << QObject::connect(&ai, &AIService::dailySummaryDraft,
+                                    [&](int userId, const QString &date, const QString &) {
+        if (draft && date == today && summaryPending.contains(userId) && !draftSeen.contains(userId)) {
+            draftSeen.insert(userId);
+            draft->samples.append(elapsed.elapsed());
+        }
+    });
+    connections << QObject::connect(&ai, &AIService::dailySummaryReady,
+                                    [&](int userId, const QString &date, const QString &) {
+        if (date == today && summaryPending.remove(userId)) {
+            finishIfDone(userId);
+        }
+    });
+    connections << QObject::connect(&ai, &AIService::todaysFortuneReady,
+                                    [&](int userId, const QString &date, const QString &) {
+        if (date == today && fortunePending.remove(userId)) {
+            finishIfDone(userId);
+        }
+    });
+
+    elapsed.start();
+    for (int userId : userIds) {
+        ai.requestHomeContent(userId);
+    }
+    QTimer::singleShot(timeoutMs, &loop, &QEventLoop::quit);
+    if (!summaryPending.isEmpty() || !fortunePending.isEmpty()) {
+        loop.exec();
+    }
+    qint64 total = elapsed.elapsed();
+
+    for (const auto &connection : connections) {
+        QObject::disconnect(connection);
+    }
+    if (!summaryPending.isEmpty() || !fortunePending.isEmpty()) {
+        out() << "  ! timed out waiting for " << summaryPending.size() << " summaries, "
+              << fortunePending.size() << " fortunes\n";
+    }
+    return total;
+}
+
+void printEndpoints()
+{
+    for (const QVariantMap &status : AIService::instance().endpointStatus()) {
+        out() << "  " << status["endpoint"].toString() << ": " << status["state"].toString()
+              << " calls=" << status["calls"].toLongLong()
+              << " failures=" << status["failures"].toLongLong()
+              << " retries=" << status["retries"].toLongLong() << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption usersOption("users", "동시 사용자 수", "N", "20");
+    QCommandLineOption roundsOption("rounds", "지연 측정 반복 횟수", "N", "10");
+    QCommandLineOption separateOption("separate", "요약과 운세를 따로 요청 (AI_COMBINED_MODE=false)");
+    parser.addOption(usersOption);
+    parser.addOption(roundsOption);
+    parser.addOption(separateOption);
+    parser.process(app);
+    int userCount = qMax(1, parser.value(usersOption).toInt());
+    int rounds = qMax(1, parser.value(roundsOption).toInt());
+
+    MockApiServer server;
+    if (!server.listen()) {
+        return 1;
+    }
+
+    // AIService/DataManager 가 만들어지기 전에 설정을 모두 로컬 서버와 임시 DB로 돌림
+    QTemporaryDir dataDir;
+    EnvLoader::set("OPENAI_BASE_URL", server.baseUrl() + "/v1");
+    EnvLoader::set("OPENAI_API_KEY", "bench");
+    EnvLoader::set("WEATHER_BASE_URL", server.baseUrl() + "/data/2.5");
+    EnvLoader::set("WEATHER_API_KEY", "bench");
+    EnvLoader::set("OPENAI_TIMEOUT_MS", "2000");
+    EnvLoader::set("AI_PREWARM", "false");
+    EnvLoader::set("AI_COMBINED_MODE", parser.isSet(separateOption) ? "false" : "true");
+    EnvLoader::set("DAILYFLOW_DB_PATH", QDir(dataDir.path()).filePath("bench.db"));
+
+    QList<int> userIds = createUsers(userCount);
+    int round = 0;
+
+    // 1. 순차 지연
+    {
+        out() << "[latency] " << rounds << " sequential home-page loads\n";
+        Stats done, firstChunk, draft;
+        for (int i = 0; i < rounds; ++i) {
+            invalidate({userIds.first()}, ++round);
+            runHomeContent({userIds.first()}, &done, &firstChunk, &draft);
+        }
+        out() << "  local draft: " << draft.text() << "\n";
+        out() << "  first chunk: " << firstChunk.text() << "\n";
+        out() << "  complete:    " << done.text() << "\n";
+        out().flush();
+    }
+
+    // 2. 동시 사용자 처리량
+    {
+        out() << "[throughput] " << userIds.size() << " concurrent users\n";
+        Stats done, firstChunk;
+        invalidate(userIds, ++round);
+        qint64 total = runHomeContent(userIds, &done, &firstChunk);
+        out() << "  complete:    " << done.text() << "\n";
+        out() << "  wall time:   " << total << "ms ("
+              << QString::number(total > 0 ? 1000.0 * done.samples.size() / total : 0.0, 'f', 1)
+              << " users/s)\n";
+        out().flush();
+    }
+
+    // 3. 저하된 상위 서버
+    struct Scenario {
+        const char *name;
+        MockApiServer::Behaviour behaviour;
+    };
+    MockApiServer::Behaviour flaky;
+    flaky.errorRate = 0.3;
+    MockApiServer::Behaviour slow;
+    slow.latencyMs = 1500;
+    slow.tokenIntervalMs = 100;
+    MockApiServer::Behaviour hanging;
+    hanging.hang = true;
+    const QList<Scenario> scenarios = {
+        {"30% 503 errors", flaky},
+        {"slow upstream (1.5s first byte)", slow},
+        {"hanging upstream (client timeout)", hanging},
+    };
+
+    QList<int> degradedUsers = userIds.mid(0, qMin(5, int(userIds.size())));
+    for (const Scenario &scenario : scenarios) {
+        out() << "[degraded] " << scenario.name << ", " << degradedUsers.size() << " users\n";
+        server.setOpenAiBehaviour(scenario.behaviour);
+        qint64 fallbacksBefore = AIMetrics::instance().value("summary.local_fallbacks");
+
+        Stats done, firstChunk;
+        invalidate(degradedUsers, ++round);
+        qint64 total = runHomeContent(degradedUsers, &done, &firstChunk);
+        out() << "  complete:    " << done.text() << " (wall " << total << "ms)\n";
+        out() << "  local fallbacks: "
+              << AIMetrics::instance().value("summary.local_fallbacks") - fallbacksBefore << "\n";
+        printEndpoints();
+        out().flush();
+    }
+
+    out() << "[mock] openai=" << server.requestCount("openai")
+          << " weather=" << server.requestCount("weather")
+          << " forecast=" << server.requestCount("forecast") << "\n";
+    out().flush();
+    return 0;
+}
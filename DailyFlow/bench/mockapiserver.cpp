@@ -0,0 +1,305 @@
+#include "mockapiserver.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <QDebug>
+
+namespace {
+
+const char *kSummaryText =
+    "📅 오늘\n\n"
+    "🌦️ 맑고 포근한 날씨예요.\n\n"
+    "━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"
+    "✨ AI 추천:\n"
+    "오전 회의와 오후 약속 사이에 여유가 있어요. 점심 후 가볍게 산책해 보세요.\n\n"
+    "📌 준비물: 노트북, 충전기";
+
+const char *kFortuneText =
+    "🌟 오늘의 운세\n\n"
+    "차분하게 하루를 시작하면 좋은 기회가 찾아와요.\n\n"
+    "🍀 행운의 색: 초록";
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 404: return "Not Found";
+    case 408: return "Request Timeout";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    default: return "Error";
+    }
+}
+
+// 텍스트를 count 조각으로 나눔 (스트리밍 흉내)
+QStringList splitText(const QString &text, int count)
+{
+    QStringList chunks;
+    count = qMax(1, count);
+    int size = qMax(1, int(text.size() / count));
+    for (int i = 0; i < text.size(); i += size) {
+        chunks.append(text.mid(i, size));
+    }
+    return chunks;
+}
+
+} // namespace
+
+MockApiServer::MockApiServer(QObject *parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &MockApiServer::onNewConnection);
+}
+
+bool MockApiServer::listen(quint16 port)
+{
+    if (!m_server->listen(QHostAddress::LocalHost, port)) {
+        qWarning() << "MockApiServer: listen failed:" << m_server->errorString();
+        return false;
+    }
+    return true;
+}
+
+quint16 MockApiServer::port() const
+{
+    return m_server->serverPort();
+}
+
+QString MockApiServer::baseUrl() const
+{
+    return QString("http://127.0.0.1:%1").arg(port());
+}
+
+void MockApiServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        m_pending.insert(socket, PendingRequest());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_pending.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockApiServer::onReadyRead(QTcpSocket *socket)
+{
+    auto it = m_pending.find(socket);
+    if (it == m_pending.end()) {
+        return;
+    }
+    PendingRequest &request = *it;
+    request.buffer.append(socket->readAll());
+
+    // 헤더가 끝날 때까지 대기
+    if (request.headerEnd < 0) {
+        request.headerEnd = request.buffer.indexOf("\r\n\r\n");
+        if (request.headerEnd < 0) {
+            return;
+        }
+        const QList<QByteArray> lines = request.buffer.left(request.headerEnd).split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.toLower().startsWith("content-length:")) {
+                request.contentLength = line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+            }
+        }
+    }
+
+    // 본문까지 다 받으면 처리 (요청마다 연결을 닫으므로 한 연결에 요청 하나)
+    qint64 bodyStart = request.headerEnd + 4;
+    if (request.buffer.size() - bodyStart < request.contentLength) {
+        return;
+    }
+    QByteArray requestLine = request.buffer.left(request.buffer.indexOf("\r\n"));
+    QList<QByteArray> parts = requestLine.split(' ');
+    QByteArray body = request.buffer.mid(bodyStart, request.contentLength);
+    m_pending.remove(socket);
+
+    if (parts.size() < 2) {
+        writeResponse(socket, 404, "text/plain", "bad request");
+        return;
+    }
+    handleRequest(socket, parts[0], parts[1], body);
+}
+
+void MockApiServer::handleRequest(QTcpSocket *socket, const QByteArray &method, const QByteArray &path,
+                                  const QByteArray &body)
+{
+    QByteArray route = path.left(path.indexOf('?') >= 0 ? path.indexOf('?') : path.size());
+
+    if (method == "POST" && route.endsWith("/chat/completions")) {
+        m_requestCounts["openai"]++;
+        handleChatCompletion(socket, body);
+    } else if (method == "GET" && route.endsWith("/weather")) {
+        m_requestCounts["weather"]++;
+        handleWeather(socket, false);
+    } else if (method == "GET" && route.endsWith("/forecast")) {
+        m_requestCounts["forecast"]++;
+        handleWeather(socket, true);
+    } else {
+        writeResponse(socket, 404, "application/json", R"({"error":"not found"})");
+    }
+}
+
+bool MockApiServer::injectFailure(QTcpSocket *socket, const Behaviour &behaviour)
+{
+    if (behaviour.hang) {
+        return true;   // 응답하지 않음 - 클라이언트의 시간 초과로 끝남
+    }
+    if (behaviour.errorRate > 0.0 && QRandomGenerator::global()->generateDouble() < behaviour.errorRate) {
+        QPointer<QTcpSocket> guard(socket);
+        int status = behaviour.errorStatus;
+        QTimer::singleShot(behaviour.latencyMs, this, [this, guard, status]() {
+            if (guard) {
+                writeResponse(guard, status, "application/json", R"({"error":{"message":"mock failure"}})");
+            }
+        });
+        return true;
+    }
+    return false;
+}
+
+void MockApiServer::handleChatCompletion(QTcpSocket *socket, const QByteArray &body)
+{
+    if (injectFailure(socket, m_openAi)) {
+        return;
+    }
+
+    QJsonObject request = QJsonDocument::fromJson(body).object();
+    bool stream = request["stream"].toBool();
+    bool jsonMode = request["response_format"].toObject()["type"].toString() == "json_object";
+
+    QString content = QString::fromUtf8(kSummaryText);
+    if (jsonMode) {
+        QJsonObject combined;
+        combined["summary"] = QString::fromUtf8(kSummaryText);
+        combined["fortune"] = QString::fromUtf8(kFortuneText);
+        content = QString::fromUtf8(QJsonDocument(combined).toJson(QJsonDocument::Compact));
+    }
+
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(m_openAi.latencyMs, this, [this, guard, stream, content]() {
+        if (!guard) {
+            return;
+        }
+        if (!stream) {
+            QJsonObject message;
+            message["role"] = "assistant";
+            message["content"] = content;
+            QJsonObject choice;
+            choice["message"] = message;
+            QJsonObject usage;
+            usage["prompt_tokens"] = 400;
+            usage["completion_tokens"] = content.size() / 2;
+            QJsonObject response;
+            response["choices"] = QJsonArray{choice};
+            response["usage"] = usage;
+            writeResponse(guard, 200, "application/json", QJsonDocument(response).toJson(QJsonDocument::Compact));
+            return;
+        }
+
+        // 본문 길이를 모르는 스트림이므로 연결 종료로 끝을 알림
+        guard->write("HTTP/1.1 200 OK\r\n"
+                     "Content-Type: text/event-stream\r\n"
+                     "Cache-Control: no-cache\r\n"
+                     "Connection: close\r\n\r\n");
+        streamChunks(guard, splitText(content, m_openAi.streamChunks), 0);
+    });
+}
+
+void MockApiServer::streamChunks(QTcpSocket *socket, const QStringList &chunks, int index)
+{
+    if (index >= chunks.size()) {
+        QJsonObject usage;
+        usage["prompt_tokens"] = 400;
+        usage["completion_tokens"] = chunks.join(QString()).size() / 2;
+        QJsonObject last;
+        last["choices"] = QJsonArray();
+        last["usage"] = usage;
+        socket->write("data: " + QJsonDocument(last).toJson(QJsonDocument::Compact) + "\n\n");
+        socket->write("data: [DONE]\n\n");
+        socket->disconnectFromHost();
+        return;
+    }
+
+    QJsonObject delta;
+    delta["content"] = chunks[index];
+    QJsonObject choice;
+    choice["delta"] = delta;
+    QJsonObject event;
+    event["choices"] = QJsonArray{choice};
+    socket->write("data: " + QJsonDocument(event).toJson(QJsonDocument::Compact) + "\n\n");
+
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(m_openAi.tokenIntervalMs, this, [this, guard, chunks, index]() {
+        if (guard) {
+            streamChunks(guard, chunks, index + 1);
+        }
+    });
+}
+
+void MockApiServer::handleWeather(QTcpSocket *socket, bool forecast)
+{
+    if (injectFailure(socket, m_weather)) {
+        return;
+    }
+
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(m_weather.latencyMs, this, [this, guard, forecast]() {
+        if (!guard) {
+            return;
+        }
+
+        auto entry = [](qint64 dt, double temp) {
+            QJsonObject main;
+            main["temp"] = temp;
+            main["humidity"] = 45;
+            QJsonObject weather;
+            weather["description"] = "맑음";
+            QJsonObject item;
+            item["dt"] = dt;
+            item["main"] = main;
+            item["weather"] = QJsonArray{weather};
+            item["pop"] = 0.1;
+            return item;
+        };
+
+        QJsonObject response;
+        qint64 now = QDateTime::currentSecsSinceEpoch();
+        if (forecast) {
+            // 5일치 3시간 간격 (OpenWeatherMap 과 같은 40개)
+            QJsonArray list;
+            for (int i = 0; i < 40; ++i) {
+                list.append(entry(now + i * 3 * 3600, 15.0 + (i % 8)));
+            }
+            response["list"] = list;
+        } else {
+            response = entry(now, 18.5);
+        }
+        writeResponse(guard, 200, "application/json", QJsonDocument(response).toJson(QJsonDocument::Compact),
+                      "Cache-Control: max-age=600\r\n");
+    });
+}
+
+void MockApiServer::writeResponse(QTcpSocket *socket, int status, const QByteArray &contentType,
+                                  const QByteArray &body, const QByteArray &extraHeaders)
+{
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + " " + reasonPhrase(status) + "\r\n"
+                          + "Content-Type: " + contentType + "\r\n"
+                          + "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                          + extraHeaders
+                          + "Connection: close\r\n\r\n"
+                          + body;
+    socket->write(response);
+    socket->disconnectFromHost();
+}
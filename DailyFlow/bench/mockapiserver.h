@@ -0,0 +1,69 @@
+#ifndef MOCKAPISERVER_H
+#define MOCKAPISERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+class QTcpServer;
+class QTcpSocket;
+
+// OpenAI(chat/completions)와 OpenWeatherMap(weather, forecast)을 흉내 내는 로컬 HTTP 서버
+// OPENAI_BASE_URL / WEATHER_BASE_URL 을 baseUrl() 로 돌리면 네트워크 없이 AIService 를 실행할 수 있음
+// 응답 지연, 스트리밍 속도, 오류 비율, 무응답(시간 초과)을 API별로 지정 가능
+class MockApiServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Behaviour {
+        int latencyMs = 50;          // 첫 바이트까지의 지연
+        int tokenIntervalMs = 15;    // 스트리밍 조각 사이 간격
+        int streamChunks = 20;       // 스트리밍 응답을 몇 조각으로 나눌지
+        double errorRate = 0.0;      // 이 비율만큼 errorStatus 로 응답
+        int errorStatus = 503;
+        bool hang = false;           // 응답하지 않고 연결만 유지 (클라이언트 시간 초과 확인용)
+    };
+
+    explicit MockApiServer(QObject *parent = nullptr);
+
+    bool listen(quint16 port = 0);   // 0 이면 빈 포트 자동 선택
+    quint16 port() const;
+    QString baseUrl() const;         // "http://127.0.0.1:<port>"
+
+    void setOpenAiBehaviour(const Behaviour &behaviour) { m_openAi = behaviour; }
+    void setWeatherBehaviour(const Behaviour &behaviour) { m_weather = behaviour; }
+
+    // "openai", "weather", "forecast" 별 받은 요청 수
+    qint64 requestCount(const QString &api) const { return m_requestCounts.value(api, 0); }
+
+private slots:
+    void onNewConnection();
+
+private:
+    // 요청 하나를 다 받을 때까지 쌓아 두는 버퍼
+    struct PendingRequest {
+        QByteArray buffer;
+        int headerEnd = -1;
+        qint64 contentLength = 0;
+    };
+
+    void onReadyRead(QTcpSocket *socket);
+    void handleRequest(QTcpSocket *socket, const QByteArray &method, const QByteArray &path, const QByteArray &body);
+    void handleChatCompletion(QTcpSocket *socket, const QByteArray &body);
+    void handleWeather(QTcpSocket *socket, bool forecast);
+    void streamChunks(QTcpSocket *socket, const QStringList &chunks, int index);
+    bool injectFailure(QTcpSocket *socket, const Behaviour &behaviour);
+    void writeResponse(QTcpSocket *socket, int status, const QByteArray &contentType,
+                       const QByteArray &body, const QByteArray &extraHeaders = QByteArray());
+
+    QTcpServer *m_server;
+    QHash<QTcpSocket *, PendingRequest> m_pending;
+    QHash<QString, qint64> m_requestCounts;
+    Behaviour m_openAi;
+    Behaviour m_weather;
+};
+
+#endif // MOCKAPISERVER_H
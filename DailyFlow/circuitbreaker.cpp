@@ -0,0 +1,78 @@
+#include "circuitbreaker.h"
+#include <QDebug>
+
+CircuitBreaker::CircuitBreaker(int failureThreshold, int openDurationMs)
+    : m_failureThreshold(failureThreshold)
+    , m_openDurationMs(openDurationMs)
+{
+}
+
+bool CircuitBreaker::allowRequest()
+{
+    switch (state()) {
+    case Closed:
+        return true;
+    case Open:
+        return false;
+    case HalfOpen:
+        // 대기 시간이 지났으면 시험 요청 하나만 허용
+        if (m_probeInFlight) {
+            return false;
+        }
+        m_state = HalfOpen;
+        m_probeInFlight = true;
+        return true;
+    }
+    return false;
+}
+
+void CircuitBreaker::recordSuccess()
+{
+    if (m_state != Closed) {
+        qDebug() << "Circuit closed";
+    }
+    m_state = Closed;
+    m_consecutiveFailures = 0;
+    m_probeInFlight = false;
+}
+
+void CircuitBreaker::recordFailure()
+{
+    m_consecutiveFailures++;
+
+    // 시험 요청이 실패했거나 연속 실패가 기준을 넘으면 다시 차단
+    if (m_probeInFlight || m_consecutiveFailures >= m_failureThreshold) {
+        if (m_state != Open) {
+            qWarning() << "Circuit opened after" << m_consecutiveFailures << "consecutive failures";
+        }
+        m_state = Open;
+        m_probeInFlight = false;
+        m_openedAt.start();
+    }
+}
+
+void CircuitBreaker::releaseProbe()
+{
+    m_probeInFlight = false;
+}
+
+CircuitBreaker::State CircuitBreaker::state() const
+{
+    if (m_state == Open && m_openedAt.elapsed() >= m_openDurationMs) {
+        return HalfOpen;
+    }
+    return m_state;
+}
+
+QString CircuitBreaker::stateName() const
+{
+    switch (state()) {
+    case Closed:
+        return "closed";
+    case Open:
+        return "open";
+    case HalfOpen:
+        return "half-open";
+    }
+    return QString();
+}
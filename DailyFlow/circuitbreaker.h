@@ -0,0 +1,42 @@
+#ifndef CIRCUITBREAKER_H
+#define CIRCUITBREAKER_H
+
+#include <QString>
+#include <QElapsedTimer>
+
+// 외부 API 하나에 대한 차단기
+// 연속 실패가 기준을 넘으면 일정 시간 요청을 보내지 않고 바로 실패 처리(Open)
+// 시간이 지나면 요청 하나만 시험 삼아 보내고(HalfOpen) 성공하면 다시 정상(Closed)
+class CircuitBreaker
+{
+public:
+    enum State {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    explicit CircuitBreaker(int failureThreshold = 5, int openDurationMs = 30000);
+
+    bool allowRequest();     // false 면 요청하지 말고 바로 실패 처리
+    void recordSuccess();
+    void recordFailure();
+    void releaseProbe();     // 시험 요청이 결과 없이 취소됨 - 성공/실패로 세지 않고 다음 시험을 허용
+
+    // allowRequest() 가 true 를 돌려준 직후에 true 면 그 요청이 HalfOpen 의 시험 요청
+    bool probeInFlight() const { return m_probeInFlight; }
+
+    State state() const;
+    QString stateName() const;
+    int consecutiveFailures() const { return m_consecutiveFailures; }
+
+private:
+    int m_failureThreshold;
+    int m_openDurationMs;
+    int m_consecutiveFailures = 0;
+    State m_state = Closed;
+    bool m_probeInFlight = false;   // HalfOpen 에서 시험 요청을 보냈는지
+    QElapsedTimer m_openedAt;
+};
+
+#endif // CIRCUITBREAKER_H
@@ -1,4 +1,5 @@
 #include "datamanager.h"
+#include "envloader.h"
 
 #include <QSqlQuery>
 #include <QSqlError>
@@ -35,7 +36,8 @@ bool DataManager::initializeDataBase()
         m_db = QSqlDatabase::database(connectionName);
     } else {
         m_db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-        m_db.setDatabaseName("dailyflow.db");
+        // DAILYFLOW_DB_PATH 로 다른 파일을 쓸 수 있음 (벤치마크가 실제 DB를 건드리지 않도록)
+        m_db.setDatabaseName(EnvLoader::get("DAILYFLOW_DB_PATH", "dailyflow.db"));
     }
 
     if( !m_db.open() ) {
@@ -90,6 +92,7 @@ bool DataManager::initializeDataBase()
         "    date TEXT NOT NULL,"
         "    summary TEXT NOT NULL,"
         "    weatherInfo TEXT,"
+        "    stale INTEGER NOT NULL DEFAULT 0,"
         "    createdAt TEXT NOT NULL,"
         "    updatedAt TEXT NOT NULL,"
         "    UNIQUE(userId, date),"
@@ -100,6 +103,74 @@ bool DataManager::initializeDataBase()
         qDebug() << "Error: Failed to create 'schedule_summaries' table:" << query.lastError().text();
         return false;
     }
+    // 이전 버전에서 만든 DB에는 stale 컬럼이 없음
+    if( !addColumnIfMissing("schedule_summaries", "stale", "INTEGER NOT NULL DEFAULT 0") ) {
+        return false;
+    }
+
+    // 'daily_fortunes' 테이블 생성
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS daily_fortunes ("
+        "    id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "    userId INTEGER NOT NULL,"
+        "    date TEXT NOT NULL,"
+        "    fortune TEXT NOT NULL,"
+        "    createdAt TEXT NOT NULL,"
+        "    updatedAt TEXT NOT NULL,"
+        "    UNIQUE(userId, date),"
+        "    FOREIGN KEY(userId) REFERENCES users(id)"
+        ");"
+        );
+    if( !success ) {
+        qDebug() << "Error: Failed to create 'daily_fortunes' table:" << query.lastError().text();
+        return false;
+    }
+
+    // 'weather_cache' 테이블 생성 (지역 단위 공유 캐시)
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS weather_cache ("
+        "    location TEXT PRIMARY KEY,"
+        "    description TEXT NOT NULL,"
+        "    temperature REAL,"
+        "    humidity INTEGER,"
+        "    fetchedAt TEXT NOT NULL,"
+        "    expiresAt TEXT NOT NULL"
+        ");"
+        );
+    if( !success ) {
+        qDebug() << "Error: Failed to create 'weather_cache' table:" << query.lastError().text();
+        return false;
+    }
+
+    // 'summary_content_cache' 테이블 생성 (프롬프트 입력 해시 → 요약)
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS summary_content_cache ("
+        "    inputHash TEXT PRIMARY KEY,"
+        "    summary TEXT NOT NULL,"
+        "    createdAt TEXT NOT NULL"
+        ");"
+        );
+    if( !success ) {
+        qDebug() << "Error: Failed to create 'summary_content_cache' table:" << query.lastError().text();
+        return false;
+    }
+
+    // 'ai_usage_daily' 테이블 생성 (AIMetrics 카운터의 일별 누적)
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS ai_usage_daily ("
+        "    date TEXT NOT NULL,"
+        "    counter TEXT NOT NULL,"
+        "    value INTEGER NOT NULL DEFAULT 0,"
+        "    PRIMARY KEY (date, counter)"
+        ");"
+        );
+    if( !success ) {
+        qDebug() << "Error: Failed to create 'ai_usage_daily' table:" << query.lastError().text();
+        return false;
+    }
+
+    // 만료된 날씨 캐시 정리
+    cleanExpiredWeather();
 
     qDebug() << "Database and tables initialized successfully.";
     return true;
@@ -189,6 +260,8 @@ bool DataManager::updateUser(int userId,
         return false;
     }
 
+    emit userInfoChanged(userId);
+
     qDebug() << "User" << userId << "updated successfully!";
     return true;
 }
@@ -244,6 +317,11 @@ bool DataManager::deleteUser(int userId)
     query.bindValue(":userId", userId);
     query.exec();
 
+    // 운세 삭제
+    query.prepare("DELETE FROM daily_fortunes WHERE userId = :userId");
+    query.bindValue(":userId", userId);
+    query.exec();
+
     // 사용자 삭제
     query.prepare("DELETE FROM users WHERE id = :userId");
     query.bindValue(":userId", userId);
@@ -254,6 +332,8 @@ bool DataManager::deleteUser(int userId)
         return false;
     }
     m_db.commit();
+    emit userInfoChanged(userId);
+
     qDebug() << "User" << userId << "deleted successfully!";
     return true;
 }
@@ -599,6 +679,39 @@ QList<QVariantMap> DataManager::getSchedulesByCategory(int userId, const QString
     return schedules;
 }
 
+ScheduleColumns DataManager::getScheduleColumns(int userId, const QString& startDate, const QString& endDate)
+{
+    ScheduleColumns columns;
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+
+    // 날짜/시간 변환은 SQLite에서 정수로 끝내서 행마다 QString 파싱을 하지 않도록 함
+    query.prepare("SELECT CAST(julianday(date) + 0.5 AS INTEGER), "
+                  "CAST(substr(startTime, 1, 2) AS INTEGER) * 60 + CAST(substr(startTime, 4, 2) AS INTEGER), "
+                  "CASE WHEN endTime IS NULL OR endTime = '' THEN NULL "
+                  "ELSE CAST(substr(endTime, 1, 2) AS INTEGER) * 60 + CAST(substr(endTime, 4, 2) AS INTEGER) END, "
+                  "COALESCE(category, ''), title "
+                  "FROM schedules WHERE userId = :userId "
+                  "AND date >= :startDate AND date <= :endDate");
+    query.bindValue(":userId", userId);
+    query.bindValue(":startDate", startDate);
+    query.bindValue(":endDate", endDate);
+
+    if (query.exec()) {
+        while (query.next()) {
+            qint16 startMinute = static_cast<qint16>(query.value(1).toInt());
+            qint16 endMinute = query.value(2).isNull() ? startMinute
+                                                       : static_cast<qint16>(query.value(2).toInt());
+            columns.append(query.value(0).toInt(), startMinute, endMinute,
+                           query.value(3).toString(), query.value(4).toString());
+        }
+    } else {
+        qDebug() << "Error: Failed to get schedule columns:" << query.lastError().text();
+    }
+
+    return columns;
+}
+
 QList<QVariantMap> DataManager::getSchedulesForNextDays(int userId, int days)
 {
     QList<QVariantMap> schedules;
@@ -663,7 +776,7 @@ QString DataManager::getCachedSummary(int userId, const QString& date)
 {
     QSqlQuery query(m_db);
     query.prepare("SELECT summary FROM schedule_summaries "
-                  "WHERE userId = :userId AND date = :date");
+                  "WHERE userId = :userId AND date = :date AND stale = 0");
     query.bindValue(":userId", userId);
     query.bindValue(":date", date);
 
@@ -674,6 +787,41 @@ QString DataManager::getCachedSummary(int userId, const QString& date)
     return QString();
 }
 
+QVariantMap DataManager::getSummaryEntry(int userId, const QString& date)
+{
+    QVariantMap entry;
+    QSqlQuery query(m_db);
+    query.prepare("SELECT summary, stale FROM schedule_summaries "
+                  "WHERE userId = :userId AND date = :date");
+    query.bindValue(":userId", userId);
+    query.bindValue(":date", date);
+
+    if (query.exec() && query.next()) {
+        entry["summary"] = query.value(0).toString();
+        entry["stale"] = query.value(1).toInt() != 0;
+    }
+
+    return entry;
+}
+
+QVariantMap DataManager::getLatestSummary(int userId)
+{
+    QVariantMap latest;
+    QSqlQuery query(m_db);
+    query.prepare("SELECT date, summary FROM schedule_summaries "
+                  "WHERE userId = :userId AND date <= :today "
+                  "ORDER BY date DESC LIMIT 1");
+    query.bindValue(":userId", userId);
+    query.bindValue(":today", QDate::currentDate().toString("yyyy-MM-dd"));
+
+    if (query.exec() && query.next()) {
+        latest["date"] = query.value(0).toString();
+        latest["summary"] = query.value(1).toString();
+    }
+
+    return latest;
+}
+
 bool DataManager::saveDailySummary(int userId, const QString& date,
                                    const QString& summary, const QString& weatherInfo)
 {
@@ -698,6 +846,8 @@ bool DataManager::saveDailySummary(int userId, const QString& date,
         return false;
     }
 
+    emit summaryChanged(userId, date);
+
     qDebug() << "Daily summary saved for" << date;
     return true;
 }
@@ -705,7 +855,7 @@ bool DataManager::saveDailySummary(int userId, const QString& date,
 bool DataManager::invalidateSummary(int userId, const QString& date)
 {
     QSqlQuery query(m_db);
-    query.prepare("DELETE FROM schedule_summaries WHERE userId = :userId AND date = :date");
+    query.prepare("UPDATE schedule_summaries SET stale = 1 WHERE userId = :userId AND date = :date");
     query.bindValue(":userId", userId);
     query.bindValue(":date", date);
 
@@ -734,13 +884,265 @@ bool DataManager::cleanOldSummaries(int daysToKeep)
 
     int deletedCount = query.numRowsAffected();
     qDebug() << "Cleaned" << deletedCount << "old summaries";
+
+    // 운세도 같은 기준으로 정리
+    query.prepare("DELETE FROM daily_fortunes WHERE updatedAt < :cutoffDate");
+    query.bindValue(":cutoffDate", cutoffDateStr);
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to clean old fortunes:" << query.lastError().text();
+        return false;
+    }
+
+    qDebug() << "Cleaned" << query.numRowsAffected() << "old fortunes";
+
+    // 내용 해시 캐시도 같은 기준으로 정리
+    query.prepare("DELETE FROM summary_content_cache WHERE createdAt < :cutoffDate");
+    query.bindValue(":cutoffDate", cutoffDateStr);
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to clean summary content cache:" << query.lastError().text();
+        return false;
+    }
+
     return true;
 }
 
+QString DataManager::getSummaryByInputHash(const QString& inputHash)
+{
+    QSqlQuery query(m_db);
+    query.prepare("SELECT summary FROM summary_content_cache WHERE inputHash = :inputHash");
+    query.bindValue(":inputHash", inputHash);
+
+    if (query.exec() && query.next()) {
+        return query.value(0).toString();
+    }
+
+    return QString();
+}
+
+bool DataManager::saveSummaryByInputHash(const QString& inputHash, const QString& summary)
+{
+    QSqlQuery query(m_db);
+    query.prepare("INSERT OR REPLACE INTO summary_content_cache (inputHash, summary, createdAt) "
+                  "VALUES (:inputHash, :summary, :createdAt)");
+    query.bindValue(":inputHash", inputHash);
+    query.bindValue(":summary", summary);
+    query.bindValue(":createdAt", QDateTime::currentDateTime().toString(Qt::ISODate));
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to save summary content cache:" << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// 오늘의 운세
+// ============================================================================
+
+QString DataManager::getCachedFortune(int userId, const QString& date)
+{
+    QSqlQuery query(m_db);
+    query.prepare("SELECT fortune FROM daily_fortunes "
+                  "WHERE userId = :userId AND date = :date");
+    query.bindValue(":userId", userId);
+    query.bindValue(":date", date);
+
+    if (query.exec() && query.next()) {
+        return query.value(0).toString();
+    }
+
+    return QString();
+}
+
+bool DataManager::saveDailyFortune(int userId, const QString& date, const QString& fortune)
+{
+    QSqlQuery query(m_db);
+    QString currentTime = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    // UPSERT (INSERT OR REPLACE)
+    query.prepare("INSERT OR REPLACE INTO daily_fortunes "
+                  "(userId, date, fortune, createdAt, updatedAt) "
+                  "VALUES (:userId, :date, :fortune, "
+                  "COALESCE((SELECT createdAt FROM daily_fortunes WHERE userId = :userId AND date = :date), :currentTime), "
+                  ":currentTime)");
+
+    query.bindValue(":userId", userId);
+    query.bindValue(":date", date);
+    query.bindValue(":fortune", fortune);
+    query.bindValue(":currentTime", currentTime);
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to save daily fortune:" << query.lastError().text();
+        return false;
+    }
+
+    qDebug() << "Daily fortune saved for" << date;
+    return true;
+}
+
+bool DataManager::invalidateFortune(int userId, const QString& date)
+{
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM daily_fortunes WHERE userId = :userId AND date = :date");
+    query.bindValue(":userId", userId);
+    query.bindValue(":date", date);
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to invalidate fortune:" << query.lastError().text();
+        return false;
+    }
+
+    qDebug() << "Fortune invalidated for" << date;
+    return true;
+}
+
+// ============================================================================
+// 날씨 캐시
+// ============================================================================
+
+QVariantMap DataManager::getCachedWeather(const QString& location)
+{
+    QVariantMap weather;
+    QSqlQuery query(m_db);
+    query.prepare("SELECT description, temperature, humidity, fetchedAt, expiresAt "
+                  "FROM weather_cache WHERE location = :location AND expiresAt > :now");
+    query.bindValue(":location", location);
+    query.bindValue(":now", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+
+    if (query.exec() && query.next()) {
+        weather["description"] = query.value(0).toString();
+        weather["temperature"] = query.value(1).toDouble();
+        weather["humidity"] = query.value(2).toInt();
+        weather["fetchedAt"] = QDateTime::fromString(query.value(3).toString(), Qt::ISODate);
+        weather["expiresAt"] = QDateTime::fromString(query.value(4).toString(), Qt::ISODate);
+    }
+
+    return weather;
+}
+
+bool DataManager::saveCachedWeather(const QString& location, const QString& description,
+                                    double temperature, int humidity,
+                                    const QDateTime& fetchedAt, const QDateTime& expiresAt)
+{
+    QSqlQuery query(m_db);
+    query.prepare("INSERT OR REPLACE INTO weather_cache "
+                  "(location, description, temperature, humidity, fetchedAt, expiresAt) "
+                  "VALUES (:location, :description, :temperature, :humidity, :fetchedAt, :expiresAt)");
+    query.bindValue(":location", location);
+    query.bindValue(":description", description);
+    query.bindValue(":temperature", temperature);
+    query.bindValue(":humidity", humidity);
+    // 만료 비교를 문자열로 하므로 항상 UTC로 저장
+    query.bindValue(":fetchedAt", fetchedAt.toUTC().toString(Qt::ISODate));
+    query.bindValue(":expiresAt", expiresAt.toUTC().toString(Qt::ISODate));
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to save weather cache:" << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+bool DataManager::cleanExpiredWeather()
+{
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM weather_cache WHERE expiresAt <= :now");
+    query.bindValue(":now", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to clean weather cache:" << query.lastError().text();
+        return false;
+    }
+
+    qDebug() << "Cleaned" << query.numRowsAffected() << "expired weather entries";
+    return true;
+}
+
+// ============================================================================
+// AI 사용량 일별 집계
+// ============================================================================
+
+bool DataManager::addUsageCounters(const QString& date, const QMap<QString, qint64>& deltas)
+{
+    QSqlQuery add(m_db);
+    add.prepare("INSERT INTO ai_usage_daily (date, counter, value) VALUES (:date, :counter, :value) "
+                "ON CONFLICT(date, counter) DO UPDATE SET value = value + excluded.value");
+    QSqlQuery max(m_db);
+    max.prepare("INSERT INTO ai_usage_daily (date, counter, value) VALUES (:date, :counter, :value) "
+                "ON CONFLICT(date, counter) DO UPDATE SET value = MAX(value, excluded.value)");
+
+    m_db.transaction();
+    for (auto it = deltas.constBegin(); it != deltas.constEnd(); ++it) {
+        // 최댓값 항목은 더하지 않고 큰 값을 유지
+        QSqlQuery &query = it.key().endsWith(".max_ms") ? max : add;
+        query.bindValue(":date", date);
+        query.bindValue(":counter", it.key());
+        query.bindValue(":value", it.value());
+        if (!query.exec()) {
+            qDebug() << "Error: Failed to save usage counter" << it.key() << ":" << query.lastError().text();
+            m_db.rollback();
+            return false;
+        }
+    }
+    m_db.commit();
+    return true;
+}
+
+QList<QVariantMap> DataManager::getUsageRollups(int days)
+{
+    QList<QVariantMap> rollups;
+    QSqlQuery query(m_db);
+    query.prepare("SELECT date, counter, value FROM ai_usage_daily "
+                  "WHERE date >= :since ORDER BY date DESC");
+    query.bindValue(":since", QDate::currentDate().addDays(-(days - 1)).toString("yyyy-MM-dd"));
+
+    if (!query.exec()) {
+        qDebug() << "Error: Failed to read usage rollups:" << query.lastError().text();
+        return rollups;
+    }
+    while (query.next()) {
+        QString date = query.value(0).toString();
+        if (rollups.isEmpty() || rollups.last()["date"].toString() != date) {
+            QVariantMap row;
+            row["date"] = date;
+            rollups.append(row);
+        }
+        rollups.last()[query.value(1).toString()] = query.value(2).toLongLong();
+    }
+
+    return rollups;
+}
+
 // ============================================================================
 // Private 헬퍼 함수
 // ============================================================================
 
+bool DataManager::addColumnIfMissing(const QString& table, const QString& column, const QString& definition)
+{
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("PRAGMA table_info(%1)").arg(table))) {
+        qDebug() << "Error: Failed to read columns of" << table << ":" << query.lastError().text();
+        return false;
+    }
+    while (query.next()) {
+        if (query.value("name").toString() == column) {
+            return true;
+        }
+    }
+
+    if (!query.exec(QString("ALTER TABLE %1 ADD COLUMN %2 %3").arg(table, column, definition))) {
+        qDebug() << "Error: Failed to add column" << column << "to" << table << ":" << query.lastError().text();
+        return false;
+    }
+
+    qDebug() << "Added column" << column << "to" << table;
+    return true;
+}
+
 QString DataManager::hashPassword(const QString& password)
 {
     QByteArray salt;
@@ -6,6 +6,8 @@
 #include <QSqlTableModel>
 #include <QList>
 #include <QVariantMap>
+#include <QDateTime>
+#include "schedulecolumns.h"
 
 // 기본적인 DB 생성과 프로그램의 기능 수행을 위해 DB에 접속해야하는 함수들의 모음
 class DataManager : public QWidget
@@ -62,6 +64,7 @@ public:
     QVariantMap getScheduleById(int scheduleId);  // 각 일정은 고유 scheduleID를 가지며 그 일정의 모든 상세 정보를 가져옴
     QList<QVariantMap> searchSchedules(int userId, const QString& keyword);  // 검색(제목, 장소, 메모 내용 중)하여 '키워드'가 포함된 일정을 가져옴 (현재 사용처 없음)
     QList<QVariantMap> getSchedulesByCategory(int userId, const QString& category);  // 카테고리에 해당하는 일정만 필터링해서 가져옴 (현재 사용처 없음)
+    ScheduleColumns getScheduleColumns(int userId, const QString& startDate, const QString& endDate);  // 기간 내 일정을 열 기반으로 가져옴 (통계페이지용)
 
     // 일정 수정 - onEditButtonClicked() 함수의 callee
     bool updateSchedule(int scheduleId, const QString& title, const QString& date,
@@ -79,21 +82,57 @@ public:
     // 요약 있으면 가져오고 없으면 생성
     QString getOrCreateDailySummary(int userId, const QString& date);
 
-    // 요약 캐시 확인
+    // 요약 캐시 확인 (무효화된 요약은 제외)
     QString getCachedSummary(int userId, const QString& date);
 
+    // 무효화 여부와 상관없이 저장된 요약 (summary, stale) - 갱신 중에도 이전 요약을 보여주기 위함
+    QVariantMap getSummaryEntry(int userId, const QString& date);
+
+    // 오늘 이전의 가장 최근 요약 (date, summary) - 시작 스냅샷용
+    QVariantMap getLatestSummary(int userId);
+
     // 요약 저장/업데이트
     bool saveDailySummary(int userId, const QString& date,
                           const QString& summary, const QString& weatherInfo);
 
-    // 요약 무효화 (일정 변경 시)
+    // 요약 무효화 (일정 변경 시) - 삭제하지 않고 stale 로 표시해서 새 요약이 나올 때까지 계속 표시
     bool invalidateSummary(int userId, const QString& date);
 
+    // 프롬프트 입력(일정, 날씨 구간, 사용자 정보) 해시로 찾는 요약 - 내용이 같으면 재생성 없이 재사용
+    QString getSummaryByInputHash(const QString& inputHash);
+    bool saveSummaryByInputHash(const QString& inputHash, const QString& summary);
+
     // 오래된 요약 삭제 (선택사항)
     bool cleanOldSummaries(int daysToKeep = 30);
 
+    // ============================================================================
+    // 오늘의 운세 캐시 (요약과 같은 수명 주기)
+    // ============================================================================
+    QString getCachedFortune(int userId, const QString& date);
+    bool saveDailyFortune(int userId, const QString& date, const QString& fortune);
+    bool invalidateFortune(int userId, const QString& date);
+
+    // ============================================================================
+    // 날씨 캐시 (사용자와 무관하게 지역 단위로 공유)
+    // ============================================================================
+    // 만료되지 않은 캐시가 있으면 description, temperature, humidity, fetchedAt, expiresAt 반환
+    QVariantMap getCachedWeather(const QString& location);
+    bool saveCachedWeather(const QString& location, const QString& description,
+                           double temperature, int humidity,
+                           const QDateTime& fetchedAt, const QDateTime& expiresAt);
+    bool cleanExpiredWeather();
+
+    // ============================================================================
+    // AI 사용량 일별 집계 (호출 수, 지연, 토큰, 캐시 적중 등 AIMetrics 카운터)
+    // ============================================================================
+    bool addUsageCounters(const QString& date, const QMap<QString, qint64>& deltas);
+    // 최근 days 일의 집계 - 행마다 "date" 와 카운터 이름별 값 (최신 날짜가 먼저)
+    QList<QVariantMap> getUsageRollups(int days = 7);
+
 signals:
     void scheduleChanged(int userId);
+    void userInfoChanged(int userId);
+    void summaryChanged(int userId, const QString& date);
 
 private:
     explicit DataManager();
@@ -102,6 +141,7 @@ private:
     DataManager& operator=(const DataManager&) = delete;
 
     bool initializeDataBase();
+    bool addColumnIfMissing(const QString& table, const QString& column, const QString& definition);  // 기존 DB 업그레이드용
 
     QSqlDatabase m_db;  // 데이터베이스 객체
     QSqlTableModel* m_model;
@@ -0,0 +1,112 @@
+#include "dayscheduler.h"
+#include "aiservice.h"
+#include "datamanager.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEvent>
+#include <QTimer>
+#include <QDebug>
+
+namespace {
+const int kTickIntervalMs = 60 * 1000;          // 1분마다 날짜/유휴 상태 확인
+const qint64 kIdleThresholdMs = 2 * 60 * 1000;  // 2분간 입력이 없으면 한가한 것으로 판단
+}
+
+DayScheduler::DayScheduler(int userId, QObject *parent)
+    : QObject(parent)
+    , m_userId(userId)
+    , m_currentDate(QDate::currentDate())
+    , m_tickTimer(new QTimer(this))
+    , m_midnightTimer(new QTimer(this))
+{
+    m_idleTimer.start();
+
+    // 정확도가 필요 없으므로 VeryCoarseTimer 로 깨어나는 횟수를 줄임
+    m_tickTimer->setTimerType(Qt::VeryCoarseTimer);
+    m_tickTimer->setInterval(kTickIntervalMs);
+    connect(m_tickTimer, &QTimer::timeout, this, &DayScheduler::onTick);
+    m_tickTimer->start();
+
+    m_midnightTimer->setSingleShot(true);
+    connect(m_midnightTimer, &QTimer::timeout, this, &DayScheduler::onTick);
+    armMidnightTimer();
+
+    // 일정이 바뀌면 미리 만든 요약이 무효화되었을 수 있으므로 다시 미리 생성 허용
+    connect(&DataManager::instance(), &DataManager::scheduleChanged,
+            this, [this](int changedUserId) {
+                if (changedUserId == m_userId) {
+                    m_prefetchedFor = QDate();
+                }
+            });
+
+    // 사용자 입력을 관찰해서 유휴 시간 계산 (이벤트는 가로채지 않음)
+    qApp->installEventFilter(this);
+}
+
+DayScheduler::~DayScheduler()
+{
+    qApp->removeEventFilter(this);
+}
+
+bool DayScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::KeyPress:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+        m_idleTimer.restart();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void DayScheduler::armMidnightTimer()
+{
+    QDateTime now = QDateTime::currentDateTime();
+    QDateTime midnight = now.date().addDays(1).startOfDay();
+    // 자정 직후에 확인하도록 1초 여유
+    m_midnightTimer->start(now.msecsTo(midnight) + 1000);
+}
+
+void DayScheduler::onTick()
+{
+    QDate today = QDate::currentDate();
+    if (today != m_currentDate) {
+        qDebug() << "Day changed:" << m_currentDate << "->" << today;
+        m_currentDate = today;
+        armMidnightTimer();
+        emit dayChanged(today);
+        return;   // 새 날짜의 화면 갱신이 먼저, 미리 생성은 다음 확인 때
+    }
+
+    if (m_idleTimer.elapsed() >= kIdleThresholdMs
+        && !AIService::instance().hasPendingRequests()) {
+        prefetchTomorrow();
+    }
+}
+
+void DayScheduler::prefetchTomorrow()
+{
+    QDate tomorrow = m_currentDate.addDays(1);
+    if (m_prefetchedFor == tomorrow) {
+        return;
+    }
+    m_prefetchedFor = tomorrow;
+
+    QString date = tomorrow.toString("yyyy-MM-dd");
+    AIService &ai = AIService::instance();
+
+    // 내일 요약이 없을 때만 일주일치를 한 번에 생성 (지난 배치로 만든 요약이 남아 있는 동안은 호출하지 않으므로
+    // 호출 비용은 대략 일주일에 한 번, 일정 수정으로 무효화된 날짜도 다음 배치에 함께 포함됨)
+    if (DataManager::instance().getCachedSummary(m_userId, date).isEmpty()) {
+        qDebug() << "Prefetching week summaries from" << m_currentDate;
+        ai.requestWeekSummaries(m_userId);
+    }
+    if (DataManager::instance().getCachedFortune(m_userId, date).isEmpty()) {
+        qDebug() << "Prefetching fortune for" << date;
+        ai.requestTodaysFortune(m_userId, false, tomorrow);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef DAYSCHEDULER_H
+#define DAYSCHEDULER_H
+
+#include <QObject>
+#include <QDate>
+#include <QElapsedTimer>
+
+class QTimer;
+
+// 날짜 변경(자정)을 감지하고, 사용자가 한가할 때 다음 날 운세와 일주일치 요약을 미리 생성
+// 그래서 하루의 첫 화면은 네트워크를 기다리지 않고 캐시에서 바로 표시됨
+class DayScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DayScheduler(int userId, QObject *parent = nullptr);
+    ~DayScheduler();
+
+signals:
+    void dayChanged(const QDate &today);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void onTick();
+
+private:
+    void armMidnightTimer();
+    void prefetchTomorrow();
+
+    int m_userId;
+    QDate m_currentDate;
+    QDate m_prefetchedFor;        // 이미 미리 생성을 요청한 날짜 (하루 한 번만)
+    QElapsedTimer m_idleTimer;    // 마지막 사용자 입력 이후 경과 시간
+    QTimer *m_tickTimer;          // 주기 확인 (절전 복귀, 시계 변경 대비)
+    QTimer *m_midnightTimer;      // 다음 자정에 맞춰 한 번 실행
+};
+
+#endif // DAYSCHEDULER_H
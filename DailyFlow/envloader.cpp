@@ -45,3 +45,7 @@ bool EnvLoader::load(const QString &filePath){
 QString EnvLoader::get(const QString &key, const QString &defaultValue){
     return envVars.value(key, defaultValue);
 }
+
+void EnvLoader::set(const QString &key, const QString &value){
+    envVars[key] = value;
+}
@@ -10,6 +10,7 @@ public:
     // 스태틱으로 만들어서 프로그램 전역에서 사용 가능
     static bool load(const QString &filePath = ".env");
     static QString get(const QString &key, const QString &defaultValue = "");
+    static void set(const QString &key, const QString &value);   // .env 값 덮어쓰기 (벤치마크 등에서 사용)
 
 private:
     static QMap<QString, QString> envVars;
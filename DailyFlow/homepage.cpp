@@ -3,9 +3,17 @@
 #include "datamanager.h"
 #include "aiservice.h"
 #include "scheduledialog.h"
+#include "snapshotstore.h"
+#include "aimetrics.h"
+#include "startuptrace.h"
 #include <QDate>
 #include <QMessageBox>
 #include <QSettings>
+#include <QTimer>
+#include <QTextCursor>
+#include <QPaintEvent>
+#include <QColor>
+#include <QShowEvent>
 
 HomePage::HomePage(int userId, QWidget *parent)
     : QWidget(parent)
@@ -26,14 +34,116 @@ HomePage::HomePage(int userId, QWidget *parent)
     connect(ui->refreshButton, &QPushButton::clicked,
             this, &HomePage::onRefreshButtonClicked);
 
+    // AI 결과는 비동기로 도착하므로 시그널로 받아서 표시
+    connect(&AIService::instance(), &AIService::dailySummaryReady,
+            this, &HomePage::onDailySummaryReady);
+    connect(&AIService::instance(), &AIService::todaysFortuneReady,
+            this, &HomePage::onTodaysFortuneReady);
+    connect(&AIService::instance(), &AIService::dailySummaryPartial,
+            this, &HomePage::onDailySummaryPartial);
+    connect(&AIService::instance(), &AIService::dailySummaryDraft,
+            this, &HomePage::onDailySummaryDraft);
+    connect(&AIService::instance(), &AIService::todaysFortunePartial,
+            this, &HomePage::onTodaysFortunePartial);
+    connect(&AIService::instance(), &AIService::forecastReady,
+            this, &HomePage::onForecastReady);
+
     // ★ 초기 테마 적용 (저장된 설정 불러오기)
     QSettings settings("DailyFlow", "Settings");
     bool isDarkMode = settings.value("darkMode", false).toBool();
     applyTheme(isDarkMode);
 
-    loadAISummary();
-    loadFortune();
-    loadUpcomingSchedules();
+    // 자리 표시(스켈레톤) → 스냅샷 순으로 먼저 그리고, 실제 조회는 창이 뜬 뒤에 패널별로 수행
+    showSkeletons();
+    applySnapshot();
+    startLoading();
+}
+
+void HomePage::startLoading()
+{
+    m_loadTimer.start();
+    m_pendingPanels = AllPanels;
+    m_completeRecorded = false;
+
+    // 패널마다 따로 이벤트 루프에 올려서 하나가 끝날 때마다 화면이 갱신되도록 함
+    // (네트워크 요청은 서로 기다리지 않고 동시에 출발)
+    // 실행 시점에 페이지가 보이지 않으면 다시 보일 때까지 미룸
+    QTimer::singleShot(0, this, [this]() {
+        if (deferIfHidden()) return;
+        loadUpcomingSchedules();
+    });
+    QTimer::singleShot(0, this, [this]() {
+        if (deferIfHidden()) return;
+        loadAIContent();
+    });
+    QTimer::singleShot(0, this, [this]() {
+        if (deferIfHidden()) return;
+        // 예보는 지역별로 캐시되므로 캐시가 유효한 동안은 네트워크 요청 없이 바로 도착
+        AIService::instance().requestForecast(m_userId);
+    });
+}
+
+bool HomePage::deferIfHidden()
+{
+    if (isVisible()) {
+        return false;
+    }
+    m_loadDeferred = true;
+    return true;
+}
+
+void HomePage::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    // 숨겨진 동안 미뤄 둔 조회를 다시 시작 (숨겨진 동안 도착해 버린 결과도 캐시에서 다시 읽음)
+    if (m_loadDeferred) {
+        m_loadDeferred = false;
+        startLoading();
+    }
+}
+
+void HomePage::paintEvent(QPaintEvent *event)
+{
+    if (!m_firstPaintRecorded) {
+        m_firstPaintRecorded = true;
+        AIMetrics::instance().recordLatency("home.first_paint", m_loadTimer.elapsed());
+        StartupTrace::mark("home.first_paint");
+    }
+    QWidget::paintEvent(event);
+}
+
+void HomePage::markPanelDone(Panel panel)
+{
+    m_pendingPanels &= ~panel;
+    if (m_pendingPanels == 0 && !m_completeRecorded) {
+        m_completeRecorded = true;
+        AIMetrics::instance().recordLatency("home.complete", m_loadTimer.elapsed());
+        StartupTrace::mark("home.complete");
+        emit loadCompleted();
+    }
+}
+
+void HomePage::showSkeletons()
+{
+    // 내용이 올 자리를 회색 막대로 표시 (스냅샷이 있으면 곧바로 덮어씀)
+    static const QString skeletonHtml =
+        "<p style='color: #9e9e9e;'>⏳ %1</p>"
+        "<p style='color: #d6d6d6;'>▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬</p>"
+        "<p style='color: #d6d6d6;'>▬▬▬▬▬▬▬▬▬▬▬▬</p>"
+        "<p style='color: #d6d6d6;'>▬▬▬▬▬▬▬▬▬▬▬▬▬▬▬</p>";
+
+    ui->scheduleList->clear();
+    m_itemToScheduleId.clear();
+    for (int i = 0; i < 3; ++i) {
+        QListWidgetItem *item = new QListWidgetItem("▬▬▬▬▬  ▬▬▬▬▬▬▬▬▬▬▬▬");
+        item->setFlags(item->flags() & ~Qt::ItemIsSelectable);
+        item->setForeground(QColor("#c8c8c8"));
+        ui->scheduleList->addItem(item);
+    }
+
+    ui->aiSummaryText->setHtml(skeletonHtml.arg("AI 일정 요약을 불러오는 중"));
+    ui->fortuneText->setHtml(skeletonHtml.arg("오늘의 운세를 불러오는 중"));
 }
 
 HomePage::~HomePage()
@@ -44,49 +154,284 @@ HomePage::~HomePage()
 void HomePage::loadAISummary()
 {
     QString today = QDate::currentDate().toString("yyyy-MM-dd");
-    QString summary = DataManager::instance().getCachedSummary(m_userId, today);
+    QVariantMap entry = DataManager::instance().getSummaryEntry(m_userId, today);
 
-    if (summary.isEmpty()) {
+    if (entry.isEmpty()) {
+        // 오늘 처음 만드는 요약 - 보여줄 이전 요약이 없으므로 바로 요청
         ui->aiSummaryText->setText("AI 일정 요약을 생성하는 중...");
+        AIService::instance().requestDailySummary(m_userId);
+    } else if (entry["stale"].toBool()) {
+        // 무효화된 요약은 그대로 보여주고 백그라운드에서 갱신
+        // (연속 수정은 RefreshScheduler 가 모아서 잠잠해진 뒤에 이리로 보냄)
+        showStaleSummary(entry["summary"].toString());
+        AIService::instance().requestDailySummary(m_userId);
+    } else {
+        m_summaryStale = false;
+        ui->aiSummaryText->setText(entry["summary"].toString());
+        setSummaryRefreshing(false);
+        markPanelDone(SummaryPanel);
+    }
+}
 
-        summary = AIService::instance().generateDailySummary(m_userId);
+void HomePage::showStaleSummary(const QString &summary)
+{
+    m_summaryStale = true;
+    ui->aiSummaryText->setText(summary);
+    setSummaryRefreshing(true);
+}
 
-        if (!summary.isEmpty()) {
-            ui->aiSummaryText->setText(summary);
-        } else {
-            ui->aiSummaryText->setText("AI 일정 요약 생성에 실패했습니다.");
-        }
-    } else {
+void HomePage::setSummaryRefreshing(bool refreshing)
+{
+    ui->aiTabWidget->setTabText(0, refreshing ? "📌 AI 오늘 일정 요약 (🔄 갱신 중)"
+                                              : "📌 AI 오늘 일정 요약");
+}
+
+void HomePage::loadAIContent()
+{
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    QVariantMap entry = DataManager::instance().getSummaryEntry(m_userId, today);
+    QString summary = entry["stale"].toBool() ? QString() : entry["summary"].toString();
+    QString fortune = DataManager::instance().getCachedFortune(m_userId, today);
+
+    if (!summary.isEmpty()) {
         ui->aiSummaryText->setText(summary);
+        markPanelDone(SummaryPanel);
+    } else if (!entry.isEmpty()) {
+        showStaleSummary(entry["summary"].toString());
+    }
+    if (!fortune.isEmpty()) {
+        ui->fortuneText->setText(fortune);
+        markPanelDone(FortunePanel);
+    }
+
+    if (!summary.isEmpty() && !fortune.isEmpty()) {
+        return;
+    } else if (!summary.isEmpty()) {
+        loadFortune();
+        return;
+    } else if (!fortune.isEmpty()) {
+        loadAISummary();
+        return;
+    }
+
+    // 운세와 요약 요청이 같은 시점에 출발해서 전체 대기 시간이 가장 느린 호출 하나에 가까워짐
+    if (!m_summaryStale) {
+        ui->aiSummaryText->setText("AI 일정 요약을 생성하는 중...");
     }
+    ui->fortuneText->setText("오늘의 운세를 생성하는 중...");
+    AIService::instance().requestHomeContent(m_userId);
 }
 
 void HomePage::loadFortune()
 {
-    ui->fortuneText->setText("오늘의 운세를 생성하는 중...");
+    // 오늘 이미 생성한 운세는 DB에서 바로 표시
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    QString fortune = DataManager::instance().getCachedFortune(m_userId, today);
+
+    if (fortune.isEmpty()) {
+        ui->fortuneText->setText("오늘의 운세를 생성하는 중...");
+        AIService::instance().requestTodaysFortune(m_userId);
+    } else {
+        ui->fortuneText->setText(fortune);
+        markPanelDone(FortunePanel);
+    }
+}
+
+void HomePage::onDailySummaryReady(int userId, const QString &date, const QString &summary)
+{
+    if (userId != m_userId || date != QDate::currentDate().toString("yyyy-MM-dd")) {
+        return;
+    }
+
+    bool notify = m_summaryRefreshRequested;
+    m_summaryRefreshRequested = false;
+    m_summaryStreaming = false;
+    m_summaryStale = false;
+    setSummaryRefreshing(false);
+    if (notify) {
+        ui->refreshButton->setEnabled(true);
+    }
+
+    // 숨겨진 동안 도착한 결과는 그리지 않음 - 다시 보일 때 캐시에서 읽어 표시
+    if (deferIfHidden()) {
+        return;
+    }
+    markPanelDone(SummaryPanel);
+
+    if (!summary.isEmpty()) {
+        ui->aiSummaryText->setText(summary);
+        if (notify) {
+            QMessageBox::information(this, "새로고침 완료", "AI 일정 요약이 갱신되었습니다.");
+        }
+    } else {
+        ui->aiSummaryText->setText("AI 일정 요약 생성에 실패했습니다.");
+        if (notify) {
+            QMessageBox::warning(this, "오류", "AI 일정 요약 생성에 실패했습니다.");
+        }
+    }
+}
+
+void HomePage::onTodaysFortuneReady(int userId, const QString &date, const QString &fortune)
+{
+    if (userId != m_userId || date != QDate::currentDate().toString("yyyy-MM-dd")) {
+        return;
+    }
+
+    bool notify = m_fortuneRefreshRequested;
+    m_fortuneRefreshRequested = false;
+    m_fortuneStreaming = false;
+    if (notify) {
+        ui->refreshButton->setEnabled(true);
+    }
 
-    QString fortune = AIService::instance().generateTodaysFortune(m_userId);
+    if (deferIfHidden()) {
+        return;
+    }
+    markPanelDone(FortunePanel);
 
     if (!fortune.isEmpty()) {
         ui->fortuneText->setText(fortune);
+        if (notify) {
+            QMessageBox::information(this, "새로고침 완료", "오늘의 운세가 갱신되었습니다.");
+        }
     } else {
         ui->fortuneText->setText("오늘의 운세 생성에 실패했습니다.");
+        if (notify) {
+            QMessageBox::warning(this, "오류", "오늘의 운세 생성에 실패했습니다.");
+        }
+    }
+}
+
+void HomePage::onDailySummaryPartial(int userId, const QString &date, const QString &delta)
+{
+    // 이전 요약을 보여주는 중이면 완성될 때까지 그대로 두고 한 번에 교체
+    if (userId != m_userId || date != QDate::currentDate().toString("yyyy-MM-dd") || m_summaryStale) {
+        return;
+    }
+    if (deferIfHidden()) {
+        return;
     }
+    appendStreamText(ui->aiSummaryText, m_summaryStreaming, delta);
+}
+
+void HomePage::onDailySummaryDraft(int userId, const QString &date, const QString &draft)
+{
+    // 스트리밍이 이미 시작됐으면 더 정확한 쪽을 유지
+    if (userId != m_userId || date != QDate::currentDate().toString("yyyy-MM-dd") || m_summaryStreaming) {
+        return;
+    }
+    // 이전 요약을 보여주며 갱신 중이거나 새로고침 버튼으로 요청했으면 완성된 결과로 한 번에 교체
+    if (m_summaryStale || m_summaryRefreshRequested || deferIfHidden()) {
+        return;
+    }
+    // 안내 문구 대신 현재 일정으로 만든 요약을 먼저 보여주고, LLM 결과가 오면 교체
+    ui->aiSummaryText->setText(draft);
+    setSummaryRefreshing(true);
+}
+
+void HomePage::onTodaysFortunePartial(int userId, const QString &date, const QString &delta)
+{
+    if (userId != m_userId || date != QDate::currentDate().toString("yyyy-MM-dd")) {
+        return;
+    }
+    if (deferIfHidden()) {
+        return;
+    }
+    appendStreamText(ui->fortuneText, m_fortuneStreaming, delta);
+}
+
+void HomePage::appendStreamText(QTextEdit *edit, bool &streaming, const QString &delta)
+{
+    // 첫 조각이 오면 "생성하는 중..." 안내 문구를 지우고 이후에는 끝에 이어 붙임
+    if (!streaming) {
+        edit->clear();
+        streaming = true;
+    }
+
+    QTextCursor cursor = edit->textCursor();
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(delta);
+    edit->setTextCursor(cursor);
 }
 
 void HomePage::refreshSchedules()
 {
     loadUpcomingSchedules();
+}
+
+void HomePage::refreshSummary()
+{
     loadAISummary();
 }
 
+void HomePage::refreshAll()
+{
+    // 어제 받던 스트리밍 조각이 남아 있지 않도록 상태 초기화
+    m_summaryStreaming = false;
+    m_fortuneStreaming = false;
+    m_summaryStale = false;
+    setSummaryRefreshing(false);
+
+    showSkeletons();
+    startLoading();
+}
+
+void HomePage::applySnapshot()
+{
+    const SnapshotStore::Snapshot &snapshot = SnapshotStore::instance().snapshot(m_userId);
+    if (!snapshot.valid) {
+        return;
+    }
+
+    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+
+    // 어제 만든 스냅샷일 수 있으므로 지난 날짜는 제외
+    QList<QVariantMap> upcoming;
+    for (const QVariantMap &schedule : snapshot.upcomingSchedules) {
+        if (schedule["date"].toString() >= today) {
+            upcoming.append(schedule);
+        }
+    }
+    showUpcomingSchedules(upcoming);
+
+    if (snapshot.summaryDate == today && !snapshot.summary.isEmpty()) {
+        ui->aiSummaryText->setText(snapshot.summary);
+    }
+}
+
 void HomePage::loadUpcomingSchedules()
 {
+    showUpcomingSchedules(DataManager::instance().getSchedulesForNextDays(m_userId, 7));
+    markPanelDone(SchedulesPanel);
+}
+
+void HomePage::onForecastReady(int userId, const QList<DayForecast> &days)
+{
+    if (userId != m_userId) {
+        return;
+    }
+    // 예보는 지역별로 캐시되므로 다시 보일 때 네트워크 없이 다시 받음
+    if (deferIfHidden()) {
+        return;
+    }
+
+    m_forecast.clear();
+    for (const DayForecast &day : days) {
+        m_forecast.insert(day.date, day);
+    }
+    showUpcomingSchedules(m_upcomingSchedules);
+    markPanelDone(ForecastPanel);
+}
+
+void HomePage::showUpcomingSchedules(const QList<QVariantMap> &schedules)
+{
+    // 야외 활동이 많은 카테고리는 일정 옆에도 예보 표시
+    static const QStringList outdoorCategories = {"약속", "개인"};
+
+    m_upcomingSchedules = schedules;
     ui->scheduleList->clear();
     m_itemToScheduleId.clear();
 
-    QList<QVariantMap> schedules = DataManager::instance().getSchedulesForNextDays(m_userId, 7);
-
     if (schedules.isEmpty()) {
         QListWidgetItem *item = new QListWidgetItem("일정이 없습니다.");
         item->setFlags(item->flags() & ~Qt::ItemIsSelectable);
@@ -94,6 +439,7 @@ void HomePage::loadUpcomingSchedules()
         return;
     }
 
+    QDate previousDate;
     for (const QVariantMap &schedule : schedules) {
         QString date = schedule["date"].toString();
         QString startTime = schedule["startTime"].toString();
@@ -105,12 +451,30 @@ void HomePage::loadUpcomingSchedules()
         QString formattedDate = qDate.toString("MM/dd");
         QString formattedTime = startTime.left(5);
 
+        // 날짜가 바뀔 때마다 그 날의 예보를 한 줄 표시 (예보가 있는 날만)
+        auto forecast = m_forecast.constFind(qDate);
+        if (qDate != previousDate && forecast != m_forecast.constEnd()) {
+            QListWidgetItem *header = new QListWidgetItem(
+                QString("🌤️ %1 (%2) %3").arg(formattedDate, dayOfWeek, forecast->shortText()));
+            header->setFlags(header->flags() & ~Qt::ItemIsSelectable);
+            ui->scheduleList->addItem(header);
+        }
+        previousDate = qDate;
+
         QString itemText = QString("📌 %1 (%2) %3 - %4")
                                .arg(formattedDate)
                                .arg(dayOfWeek)
                                .arg(formattedTime)
                                .arg(title);
 
+        if (forecast != m_forecast.constEnd()
+            && outdoorCategories.contains(schedule["category"].toString())) {
+            itemText += QString("  [%1 %2°C]").arg(forecast->description).arg(qRound(forecast->temperature));
+            if (forecast->precipitationChance >= 50) {
+                itemText += " ☔";
+            }
+        }
+
         QListWidgetItem *item = new QListWidgetItem(itemText);
         ui->scheduleList->addItem(item);
 
@@ -161,6 +525,15 @@ void HomePage::displayScheduleDetail(int scheduleId)
                        .arg(schedule["category"].toString().isEmpty() ? "없음" : schedule["category"].toString())
                        .arg(schedule["memo"].toString().isEmpty() ? "없음" : schedule["memo"].toString());
 
+    // 주간 배치로 미리 만든 그 날의 요약이 있으면 함께 표시
+    QString daySummary = DataManager::instance().getCachedSummary(m_userId, schedule["date"].toString());
+    if (!daySummary.isEmpty()) {
+        html += QString("<hr style='margin: 10px 0; border: none; border-top: 1px solid #ddd;'>"
+                        "<p style='margin: 5px 0;'><b>✨ 이날 요약:</b></p>"
+                        "<p style='margin: 5px 0; padding-left: 10px;'>%1</p>")
+                    .arg(daySummary.toHtmlEscaped().replace("\n", "<br>"));
+    }
+
     ui->scheduleDetail->setHtml(html);
 }
 
@@ -218,8 +591,6 @@ void HomePage::onDeleteButtonClicked()
         if (DataManager::instance().deleteSchedule(scheduleId)) {
             QMessageBox::information(this, "삭제 완료", "일정이 삭제되었습니다.");
 
-            loadUpcomingSchedules();
-
             ui->scheduleDetail->setText("일정을 선택하세요.");
             ui->editButton->setEnabled(false);
             ui->deleteButton->setEnabled(false);
@@ -234,35 +605,28 @@ void HomePage::onRefreshButtonClicked()
     // 현재 선택된 탭 확인
     int currentTab = ui->aiTabWidget->currentIndex();
 
+    // 결과가 도착할 때까지 중복 클릭 방지
+    ui->refreshButton->setEnabled(false);
+
     if (currentTab == 0) {
         // AI 일정 요약 탭
         QString today = QDate::currentDate().toString("yyyy-MM-dd");
         DataManager::instance().invalidateSummary(m_userId, today);
 
-        ui->aiSummaryText->setText("AI 일정 요약을 새로 생성하는 중...");
-
-        QString summary = AIService::instance().generateDailySummary(m_userId);
-
-        if (!summary.isEmpty()) {
-            ui->aiSummaryText->setText(summary);
-            QMessageBox::information(this, "새로고침 완료", "AI 일정 요약이 갱신되었습니다.");
+        // 새 요약이 나올 때까지 지금 요약을 그대로 표시
+        m_summaryRefreshRequested = true;
+        QString current = DataManager::instance().getSummaryEntry(m_userId, today)["summary"].toString();
+        if (current.isEmpty()) {
+            ui->aiSummaryText->setText("AI 일정 요약을 새로 생성하는 중...");
         } else {
-            ui->aiSummaryText->setText("AI 일정 요약 생성에 실패했습니다.");
-            QMessageBox::warning(this, "오류", "AI 일정 요약 생성에 실패했습니다.");
+            showStaleSummary(current);
         }
+        AIService::instance().requestDailySummary(m_userId, true);
     } else {
         // 오늘의 운세 탭
         ui->fortuneText->setText("오늘의 운세를 새로 생성하는 중...");
-
-        QString fortune = AIService::instance().generateTodaysFortune(m_userId);
-
-        if (!fortune.isEmpty()) {
-            ui->fortuneText->setText(fortune);
-            QMessageBox::information(this, "새로고침 완료", "오늘의 운세가 갱신되었습니다.");
-        } else {
-            ui->fortuneText->setText("오늘의 운세 생성에 실패했습니다.");
-            QMessageBox::warning(this, "오류", "오늘의 운세 생성에 실패했습니다.");
-        }
+        m_fortuneRefreshRequested = true;
+        AIService::instance().requestTodaysFortune(m_userId, true);
     }
 }
 
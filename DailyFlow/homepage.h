@@ -4,6 +4,11 @@
 #include <QWidget>
 #include <QListWidgetItem>
 #include <QMap>
+#include <QVariantMap>
+#include <QElapsedTimer>
+#include "aiservice.h"
+
+class QTextEdit;
 
 namespace Ui {
 class HomePage;
@@ -18,24 +23,71 @@ public:
     ~HomePage();
 
 public slots:
-    void refreshSchedules();
+    void refreshSchedules();   // 다가오는 일정 목록만 다시 조회
+    void refreshSummary();     // 바뀐 일정으로 AI 요약 갱신 (RefreshScheduler 가 수정이 멈춘 뒤 호출)
+    void refreshAll();   // 날짜가 바뀌었을 때 전체 다시 불러오기
     void applyTheme(bool isDarkMode);
 
+signals:
+    void loadCompleted();   // 모든 패널이 처음 채워짐 (MainWindow 가 남은 페이지를 미리 만드는 시점)
+
 private slots:
     void onScheduleItemClicked(QListWidgetItem *item);
     void onEditButtonClicked();
     void onDeleteButtonClicked();
     void onRefreshButtonClicked();    // 통합 새로고침 버튼
+    void onDailySummaryReady(int userId, const QString &date, const QString &summary);
+    void onTodaysFortuneReady(int userId, const QString &date, const QString &fortune);
+    void onDailySummaryPartial(int userId, const QString &date, const QString &delta);
+    void onDailySummaryDraft(int userId, const QString &date, const QString &draft);
+    void onTodaysFortunePartial(int userId, const QString &date, const QString &delta);
+    void onForecastReady(int userId, const QList<DayForecast> &days);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;   // 첫 그리기 시점 기록
 
 private:
+    // 따로 불러오는 패널 - 모두 끝나면 "home.complete" 기록
+    enum Panel {
+        SchedulesPanel = 0x1,
+        SummaryPanel = 0x2,
+        FortunePanel = 0x4,
+        ForecastPanel = 0x8,
+        AllPanels = SchedulesPanel | SummaryPanel | FortunePanel | ForecastPanel
+    };
+
     Ui::HomePage *ui;
     int m_userId;
     QMap<QListWidgetItem*, int> m_itemToScheduleId;
+    QList<QVariantMap> m_upcomingSchedules;   // 예보가 도착하면 다시 그리기 위해 보관
+    QMap<QDate, DayForecast> m_forecast;
+    bool m_summaryRefreshRequested = false;   // 새로고침 버튼으로 요청했으면 완료 시 알림
+    bool m_fortuneRefreshRequested = false;
+    bool m_summaryStreaming = false;          // 스트리밍 조각을 받는 중 (첫 조각이 안내 문구를 대체)
+    bool m_fortuneStreaming = false;
+    bool m_summaryStale = false;              // 무효화된 이전 요약을 보여주며 갱신을 기다리는 중
+    QElapsedTimer m_loadTimer;                // 생성(또는 전체 새로고침) 시점부터
+    int m_pendingPanels = AllPanels;
+    bool m_firstPaintRecorded = false;
+    bool m_completeRecorded = false;
+    bool m_loadDeferred = false;              // 숨겨진 상태라 조회를 미루거나 도착한 결과를 그리지 않음
+
+    void startLoading();
+    bool deferIfHidden();
+    void showSkeletons();
+    void markPanelDone(Panel panel);
 
     void loadAISummary();
+    void showStaleSummary(const QString &summary);
+    void setSummaryRefreshing(bool refreshing);
     void loadFortune();
+    void loadAIContent();   // 요약과 운세를 동시에 요청
     void loadUpcomingSchedules();
+    void showUpcomingSchedules(const QList<QVariantMap> &schedules);
+    void applySnapshot();
     void displayScheduleDetail(int scheduleId);
+    void appendStreamText(QTextEdit *edit, bool &streaming, const QString &delta);
 };
 
 #endif // HOMEPAGE_H
@@ -0,0 +1,43 @@
+#include "latencyhistogram.h"
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(bucketBounds().size() + 1, 0)
+{
+}
+
+const QVector<qint64> &LatencyHistogram::bucketBounds()
+{
+    static const QVector<qint64> bounds = {
+        25, 50, 75, 100, 150, 200, 300, 400, 500, 750,
+        1000, 1500, 2000, 3000, 4000, 5000, 7500, 10000,
+        15000, 20000, 30000, 60000
+    };
+    return bounds;
+}
+
+void LatencyHistogram::record(qint64 ms)
+{
+    const QVector<qint64> &bounds = bucketBounds();
+    auto it = std::lower_bound(bounds.begin(), bounds.end(), ms);
+    m_buckets[int(it - bounds.begin())]++;
+    m_count++;
+}
+
+qint64 LatencyHistogram::percentile(double p) const
+{
+    if (m_count == 0) {
+        return -1;
+    }
+
+    const QVector<qint64> &bounds = bucketBounds();
+    qint64 target = qMax<qint64>(1, qint64(p * m_count + 0.5));
+    qint64 seen = 0;
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) {
+            return i < bounds.size() ? bounds[i] : bounds.last() * 2;
+        }
+    }
+    return bounds.last() * 2;
+}
@@ -0,0 +1,27 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// 고정 구간(25ms ~ 60s) 지연 히스토그램
+// 표본을 모두 보관하지 않고 구간별 개수만 세므로 메모리와 기록 비용이 일정함
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(qint64 ms);
+    qint64 count() const { return m_count; }
+
+    // p (0~1) 분위수가 속한 구간의 상한 (표본이 없으면 -1)
+    qint64 percentile(double p) const;
+
+    static const QVector<qint64> &bucketBounds();
+
+private:
+    QVector<qint64> m_buckets;   // bucketBounds() 와 같은 크기 + 상한 초과 구간
+    qint64 m_count = 0;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,44 @@
+#include "llmendpoint.h"
+#include "envloader.h"
+#include <QDebug>
+
+QList<LlmEndpoint> LlmEndpoint::fromEnvironment()
+{
+    QList<LlmEndpoint> endpoints;
+
+    const QStringList names = EnvLoader::get("LLM_ENDPOINTS").split(',', Qt::SkipEmptyParts);
+    for (QString name : names) {
+        name = name.trimmed();
+        QString prefix = "LLM_" + name.toUpper() + "_";
+
+        LlmEndpoint endpoint;
+        endpoint.name = name.toLower();
+        endpoint.url = QUrl(EnvLoader::get(prefix + "URL"));
+        endpoint.model = EnvLoader::get(prefix + "MODEL", "gpt-4o-mini");
+        endpoint.apiKey = EnvLoader::get(prefix + "API_KEY");
+
+        if (!endpoint.url.isValid() || endpoint.url.host().isEmpty()) {
+            qWarning() << "LLM endpoint" << name << "has no valid URL, skipped";
+            continue;
+        }
+        endpoints.append(endpoint);
+    }
+
+    if (endpoints.isEmpty()) {
+        LlmEndpoint endpoint;
+        endpoint.name = "openai";
+        // OPENAI_BASE_URL 로 로컬 대역 서버 등 호환 서버를 가리킬 수 있음
+        QString baseUrl = EnvLoader::get("OPENAI_BASE_URL", "https://api.openai.com/v1");
+        while (baseUrl.endsWith('/')) {
+            baseUrl.chop(1);
+        }
+        endpoint.url = QUrl(baseUrl + "/chat/completions");
+        endpoint.model = "gpt-4o-mini";
+        endpoint.apiKey = EnvLoader::get("OPENAI_API_KEY");
+        if (!endpoint.apiKey.isEmpty()) {
+            endpoints.append(endpoint);
+        }
+    }
+
+    return endpoints;
+}
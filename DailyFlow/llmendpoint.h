@@ -0,0 +1,21 @@
+#ifndef LLMENDPOINT_H
+#define LLMENDPOINT_H
+
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+// OpenAI 호환 chat/completions 엔드포인트 하나 (클라우드, 로컬 서버 등)
+struct LlmEndpoint {
+    QString name;      // 지표/차단기 이름 (기본 클라우드는 "openai")
+    QUrl url;
+    QString model;
+    QString apiKey;    // 로컬 서버는 비어 있어도 됨
+
+    // LLM_ENDPOINTS=cloud,local 처럼 이름을 나열하고 이름별로
+    // LLM_<NAME>_URL, LLM_<NAME>_MODEL, LLM_<NAME>_API_KEY 를 지정
+    // 설정이 없으면 OPENAI_API_KEY 를 쓰는 기본 OpenAI 엔드포인트 하나
+    static QList<LlmEndpoint> fromEnvironment();
+};
+
+#endif // LLMENDPOINT_H
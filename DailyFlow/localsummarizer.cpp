@@ -0,0 +1,231 @@
+#include "localsummarizer.h"
+#include <QMap>
+#include <QStringList>
+#include <QTime>
+#include <algorithm>
+
+namespace {
+
+const int kBackToBackMinutes = 10;   // 이 간격 이하로 이어지면 연속 일정
+const int kGapMinutes = 90;          // 이 이상 비면 빈 시간으로 안내
+
+// 요약에 쓰는 일정 하나 (시간은 분 단위, 모르면 -1)
+struct Slot {
+    QString title;
+    QString category;
+    QString location;
+    int start = -1;
+    int end = -1;
+};
+
+// 날씨 설명에 들어 있는 키워드 → 조언 (앞쪽일수록 우선)
+struct WeatherAdvice {
+    const char *keyword;
+    const char *advice;
+    bool badForOutdoor;
+};
+
+const WeatherAdvice kWeatherAdvice[] = {
+    {"뇌우", "천둥번개 소식이 있어요. 야외 일정은 실내로 옮기는 것을 고려해 보세요.", true},
+    {"천둥", "천둥번개 소식이 있어요. 야외 일정은 실내로 옮기는 것을 고려해 보세요.", true},
+    {"진눈깨비", "진눈깨비로 길이 미끄러울 수 있어요. 이동 시간을 넉넉히 잡으세요.", true},
+    {"소나기", "갑작스러운 소나기에 대비해 우산을 챙기세요.", true},
+    {"비", "비 소식이 있으니 우산을 꼭 챙기세요.", true},
+    {"눈", "눈이 예보되어 있어요. 길이 미끄러우니 이동 시간을 넉넉히 잡으세요.", true},
+    {"안개", "안개가 끼니 운전하실 때 조심하세요.", false},
+    {"박무", "시야가 흐릴 수 있으니 이동 시 주의하세요.", false},
+    {"연무", "공기가 탁할 수 있어요. 마스크를 챙기면 좋아요.", false},
+    {"황사", "황사가 있어요. 마스크를 챙기고 야외 활동은 줄이세요.", true},
+    {"먼지", "먼지가 많아요. 마스크를 챙기면 좋아요.", false},
+    {"흐림", "하늘이 흐려요. 컨디션 관리에 신경 써 주세요.", false},
+    {"구름", "구름이 조금 있지만 활동하기 무난한 날씨예요.", false},
+    {"맑음", "맑은 날씨예요. 잠깐이라도 바깥 공기를 쐬어 보세요.", false},
+};
+
+const QStringList kOutdoorCategories = {"약속", "개인"};
+
+int toMinutes(const QString &text)
+{
+    QTime time = QTime::fromString(text, "HH:mm");
+    if (!time.isValid()) {
+        time = QTime::fromString(text, "H:mm");
+    }
+    return time.isValid() ? time.hour() * 60 + time.minute() : -1;
+}
+
+QString formatMinutes(int minutes)
+{
+    return QString("%1:%2").arg(minutes / 60, 2, 10, QChar('0')).arg(minutes % 60, 2, 10, QChar('0'));
+}
+
+QString slotText(const Slot &slot)
+{
+    QString text = slot.title;
+    if (slot.start >= 0) {
+        text += QString(" (%1)").arg(formatMinutes(slot.start));
+    }
+    return text;
+}
+
+const WeatherAdvice *findWeatherAdvice(const QString &description)
+{
+    for (const WeatherAdvice &entry : kWeatherAdvice) {
+        if (description.contains(QString::fromUtf8(entry.keyword))) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+QStringList adviceLines(const LocalSummarizer::Input &input, const QList<Slot> &items)
+{
+    QStringList advice;
+
+    bool hasOutdoor = std::any_of(items.begin(), items.end(), [](const Slot &slot) {
+        return kOutdoorCategories.contains(slot.category);
+    });
+
+    if (input.weatherValid) {
+        const WeatherAdvice *entry = findWeatherAdvice(input.weatherDescription);
+        if (entry) {
+            advice.append(QString::fromUtf8(entry->advice));
+            if (entry->badForOutdoor && hasOutdoor) {
+                advice.append("바깥에서 하는 약속이나 개인 일정은 장소를 한 번 더 확인해 두세요.");
+            }
+        }
+        if (input.temperature >= 30.0) {
+            advice.append("무더운 날씨예요. 물을 자주 마시고 한낮 이동은 피하세요.");
+        } else if (input.temperature <= 0.0) {
+            advice.append("영하의 추위예요. 따뜻하게 껴입고 나가세요.");
+        } else if (input.temperature <= 8.0) {
+            advice.append("쌀쌀하니 겉옷을 챙기세요.");
+        }
+    }
+
+    if (items.size() >= 5) {
+        advice.append(QString("일정이 %1개나 있어요. 중간중간 쉬는 시간을 챙기세요.").arg(items.size()));
+    }
+    return advice;
+}
+
+} // namespace
+
+namespace LocalSummarizer {
+
+QString summarize(const Input &input)
+{
+    QList<Slot> items;
+    items.reserve(input.schedules.size());
+    for (const QVariantMap &schedule : input.schedules) {
+        Slot slot;
+        slot.title = schedule["title"].toString().trimmed();
+        slot.category = schedule["category"].toString();
+        slot.location = schedule["location"].toString();
+        slot.start = toMinutes(schedule["startTime"].toString());
+        slot.end = toMinutes(schedule["endTime"].toString());
+        items.append(slot);
+    }
+    // 시간 미정 일정은 맨 뒤로
+    std::stable_sort(items.begin(), items.end(), [](const Slot &a, const Slot &b) {
+        if ((a.start < 0) != (b.start < 0)) {
+            return b.start < 0;
+        }
+        return a.start < b.start;
+    });
+
+    QString text = QString("📅 %1\n\n").arg(input.dateKorean);
+    if (input.weatherValid) {
+        text += QString("🌦️ %1\n\n").arg(input.weatherText);
+    }
+    text += "━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n";
+
+    if (items.isEmpty()) {
+        text += QString("✨ %1님, %2은 등록된 일정이 없어요.\n").arg(input.userName, input.dayLabel);
+        text += "여유로운 시간을 마음껏 즐겨 보세요.\n";
+    } else {
+        text += QString("✨ %1님의 %2 일정 (%3개):\n").arg(input.userName, input.dayLabel).arg(items.size());
+
+        // 시간대별 묶음
+        QStringList morning, afternoon, evening, untimed;
+        for (const Slot &slot : items) {
+            if (slot.start < 0) {
+                untimed.append(slotText(slot));
+            } else if (slot.start < 12 * 60) {
+                morning.append(slotText(slot));
+            } else if (slot.start < 18 * 60) {
+                afternoon.append(slotText(slot));
+            } else {
+                evening.append(slotText(slot));
+            }
+        }
+        if (!morning.isEmpty()) {
+            text += QString("🌅 오전: %1\n").arg(morning.join(", "));
+        }
+        if (!afternoon.isEmpty()) {
+            text += QString("☀️ 오후: %1\n").arg(afternoon.join(", "));
+        }
+        if (!evening.isEmpty()) {
+            text += QString("🌙 저녁: %1\n").arg(evening.join(", "));
+        }
+        if (!untimed.isEmpty()) {
+            text += QString("🕒 시간 미정: %1\n").arg(untimed.join(", "));
+        }
+
+        // 카테고리별 개수 (처음 나온 순서대로)
+        QStringList categoryOrder;
+        QMap<QString, int> categoryCounts;
+        for (const Slot &slot : items) {
+            QString category = slot.category.isEmpty() ? QString("기타") : slot.category;
+            if (!categoryCounts.contains(category)) {
+                categoryOrder.append(category);
+            }
+            categoryCounts[category]++;
+        }
+        QStringList categoryParts;
+        for (const QString &category : categoryOrder) {
+            categoryParts.append(QString("%1 %2").arg(category).arg(categoryCounts[category]));
+        }
+        text += QString("🗂️ 분류: %1\n").arg(categoryParts.join(" · "));
+
+        // 연달아 붙은 일정과 빈 시간
+        // 바로 앞 일정이 아니라 지금까지 가장 늦게 끝나는 일정과 비교 (긴 일정 안에 든 일정은 빈 시간을 만들지 않음)
+        QStringList backToBack;
+        QStringList gaps;
+        int busyUntil = -1;
+        QString busyTitle;
+        for (const Slot &current : items) {
+            if (current.start < 0) {
+                break;   // 시간 미정 일정은 맨 뒤에만 있음
+            }
+            int currentEnd = current.end > current.start ? current.end : current.start;
+            if (busyUntil >= 0) {
+                int between = current.start - busyUntil;
+                if (between >= kGapMinutes) {
+                    gaps.append(QString("%1~%2").arg(formatMinutes(busyUntil), formatMinutes(current.start)));
+                } else if (between <= kBackToBackMinutes && currentEnd > busyUntil) {
+                    backToBack.append(QString("%1 → %2").arg(busyTitle, current.title));
+                }
+            }
+            if (currentEnd > busyUntil) {
+                busyUntil = currentEnd;
+                busyTitle = current.title;
+            }
+        }
+        if (!backToBack.isEmpty()) {
+            text += QString("⏱️ 연달아 있는 일정: %1 (이동/휴식 시간을 미리 챙기세요)\n").arg(backToBack.join(", "));
+        }
+        if (!gaps.isEmpty()) {
+            text += QString("☕ 여유 시간: %1\n").arg(gaps.join(", "));
+        }
+    }
+
+    QStringList advice = adviceLines(input, items);
+    if (!advice.isEmpty()) {
+        text += "\n💡 " + advice.join("\n💡 ") + "\n";
+    }
+
+    text += "\n좋은 하루 보내세요! 😊";
+    return text;
+}
+
+} // namespace LocalSummarizer
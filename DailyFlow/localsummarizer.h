@@ -0,0 +1,29 @@
+#ifndef LOCALSUMMARIZER_H
+#define LOCALSUMMARIZER_H
+
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+
+// 네트워크 없이 규칙만으로 만드는 일정 요약
+// LLM 응답이 오기 전에 먼저 보여주고, API 키가 없거나 호출이 실패하면 그대로 최종 요약으로 사용
+namespace LocalSummarizer {
+
+struct Input {
+    QString userName;
+    QString dateKorean;
+    QString dayLabel;              // "오늘" 또는 "이날"
+    bool weatherValid = false;
+    QString weatherText;           // WeatherInfo::text()
+    QString weatherDescription;    // "맑음", "약한 비" 등
+    double temperature = 0.0;
+    QList<QVariantMap> schedules;  // getSchedulesByDate 결과
+};
+
+// 시간대(오전/오후/저녁)와 카테고리별로 묶고, 연달아 붙은 일정과 빈 시간을 찾아
+// 날씨 키워드 표에 따른 조언과 함께 summaryFormat 과 같은 모양으로 작성
+QString summarize(const Input &input);
+
+} // namespace LocalSummarizer
+
+#endif // LOCALSUMMARIZER_H
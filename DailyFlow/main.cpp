@@ -2,30 +2,45 @@
 #include "envloader.h"
 #include "logindialog.h"
 #include "datamanager.h"
+#include "snapshotstore.h"
 #include "aiservice.h"
+#include "startuptrace.h"
 #include <QDialog>
 #include <QApplication>
+#include <QTimer>
 #include <QEventLoop>  // MainWindow가 닫힐 때까지 대기하기 위해
 #include <QDebug>
 
 int main(int argc, char *argv[])
 {
+    StartupTrace::start();
     QApplication a(argc, argv);
 
     if(!EnvLoader::load(".env")){
         qWarning() << ".env file not found or invalid!";
     }
 
-    // DataManager, ai service 싱글톤 인스턴스 생성
-    DataManager::instance();
+    // ai service 싱글톤 인스턴스 생성
     AIService::instance();
 
+    // DB 열기와 테이블 생성은 로그인 창이 먼저 그려진 뒤에 수행
+    // (그 전에 로그인 버튼이 눌리면 instance() 호출 시점에 바로 열림)
+    // 스냅샷 저장용 변경 알림도 DB 가 열린 뒤에 구독
+    QTimer::singleShot(0, []() {
+        DataManager::instance();
+        SnapshotStore::instance().watchDatabase();
+    });
+
     bool restartLoop = true; // 로그아웃 시 루프를 다시 시작하기 위한 플래그
 
     a.setWindowIcon(QIcon(":/logo.png"));  // 프로그램 실행 아이콘
     while (restartLoop)
     {
         LoginDialog loginDialog;
+        StartupTrace::mark("login.constructed");
+
+        // 사용자가 로그인 정보를 입력하는 동안 API 서버와 미리 연결
+        QTimer::singleShot(0, []() { AIService::instance().warmUpConnections(); });
 
         if (loginDialog.exec() == QDialog::Accepted) {
 
@@ -34,11 +49,13 @@ int main(int argc, char *argv[])
             qDebug() << "로그인 성공! User ID:" << userId;
 
             MainWindow w(userId); // MainWindow 생성
+            StartupTrace::mark("main_window.constructed");
 
             // MainWindow가 닫힐 때까지 대기하는 로컬 이벤트 루프
             QEventLoop loop;
             QObject::connect(&w, &MainWindow::windowClosed, &loop, &QEventLoop::quit);
             w.show();
+            StartupTrace::mark("main_window.shown");
             loop.exec(); // windowClosed 신호가 올 때까지 대기
 
             // MainWindow가 닫힌 이유를 확인
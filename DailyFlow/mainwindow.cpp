@@ -2,8 +2,16 @@
 #include "ui_mainwindow.h"
 #include "homepage.h"
 #include "schedulepage.h"
+#include "statisticspage.h"
 #include "settingspage.h"
 #include "datamanager.h"
+#include "snapshotstore.h"
+#include "dayscheduler.h"
+#include "refreshscheduler.h"
+#include "aiservice.h"
+#include "envloader.h"
+#include "startuptrace.h"
+#include <QElapsedTimer>
 #include <QMessageBox>
 #include <QVariantMap>
 #include <QTimer>
@@ -15,7 +23,11 @@ MainWindow::MainWindow(const int &userId, QWidget *parent)
     , m_Id(userId)
 {
     ui->setupUi(this);
-    QVariantMap userInfo = DataManager::instance().getUserInfo(userId);
+
+    // 스냅샷이 있으면 DB 조회 없이 사용자 정보를 표시
+    const SnapshotStore::Snapshot &snapshot = SnapshotStore::instance().snapshot(userId);
+    QVariantMap userInfo = snapshot.valid ? snapshot.userInfo
+                                          : DataManager::instance().getUserInfo(userId);
 
     // 오류 검출: 사용자 정보가 비어있는지 확인
     if (userInfo.isEmpty()) {
@@ -40,46 +52,48 @@ MainWindow::MainWindow(const int &userId, QWidget *parent)
     // 사용자 이름 설정
     ui->userLabel->setText(m_userName + "님");
 
-    // 각 페이지 생성
-    m_homePage = new HomePage(m_Id, this);
-    m_schedulePage = new SchedulePage(m_Id, this);
-    m_settingsPage = new SettingsPage(m_Id, this);
+    // 일정 변경 알림은 여기서 모아서 각 페이지에 전달 (페이지는 만들 때 등록)
+    m_refreshScheduler = new RefreshScheduler(m_Id, this);
 
-    // 스택 위젯에 페이지 추가
-    ui->stackedWidget->addWidget(m_homePage);
-    ui->stackedWidget->addWidget(m_schedulePage);
-    ui->stackedWidget->addWidget(m_settingsPage);
+    // 홈 페이지만 바로 만들고 나머지는 처음 이동할 때 생성
+    QElapsedTimer createTimer;
+    createTimer.start();
+    m_homePage = new HomePage(m_Id, this);
+    addPage(m_homePage, "home", createTimer.elapsed());
+    m_refreshScheduler->addPage(m_homePage, RefreshScheduler::Cheap,
+                                [this]() { m_homePage->refreshSchedules(); });
+    m_refreshScheduler->addPage(m_homePage, RefreshScheduler::Expensive,
+                                [this]() { m_homePage->refreshSummary(); });
 
     // 네비게이션 버튼 시그널 연결
     connect(ui->homeButton, &QPushButton::clicked, this, &MainWindow::showHomePage);
     connect(ui->scheduleButton, &QPushButton::clicked, this, &MainWindow::showSchedulePage);
+    connect(ui->statisticsButton, &QPushButton::clicked, this, &MainWindow::showStatisticsPage);
     connect(ui->settingsButton, &QPushButton::clicked, this, &MainWindow::showSettingsPage);
 
-    connect(m_settingsPage, &SettingsPage::themeChanged,
-            this, [](bool isDark){
-                qDebug() << "테마 변경됨:" << (isDark ? "다크모드" : "라이트모드");
-            });
-
-    connect(m_settingsPage, &SettingsPage::themeChanged,
-            m_homePage, &HomePage::applyTheme);
-
-    connect(m_settingsPage, &SettingsPage::themeChanged,
-            m_schedulePage, &SchedulePage::applyTheme);
+    // 홈 화면이 다 채워진 뒤 남은 페이지를 한가할 때 하나씩 미리 만듦
+    // 홈 로딩이 끝나지 않더라도 (네트워크 지연 등) 일정 시간 뒤에는 시작
+    if (EnvLoader::get("PAGE_PRECONSTRUCT", "true").toLower() != "false") {
+        connect(m_homePage, &HomePage::loadCompleted, this, &MainWindow::startPreconstruct);
+        QTimer::singleShot(5000, this, &MainWindow::startPreconstruct);
+    }
 
     // 로그아웃 버튼 연결
     connect(ui->logoutButton, &QPushButton::clicked, this, &MainWindow::handleLogout);
 
-    // 회원 탈퇴 시 로그아웃 처리
-    connect(m_settingsPage, &SettingsPage::logoutRequested,
-            this, &MainWindow::close);
-
-    connect(&DataManager::instance(), &DataManager::scheduleChanged,
-            this, [this](int userId) {
-                if (userId == m_Id) {
-                    m_homePage->refreshSchedules();
-                }
+    // 앱을 켜 둔 채 자정이 지나면 새 날짜 기준으로 다시 불러옴
+    m_dayScheduler = new DayScheduler(m_Id, this);
+    connect(m_dayScheduler, &DayScheduler::dayChanged,
+            this, [this](const QDate &) {
+                m_homePage->refreshAll();
+                SnapshotStore::instance().scheduleSave(m_Id);
             });
 
+    // 스냅샷이 없었던 첫 로그인이면 다음 시작을 위해 바로 만들어 둠
+    if (!snapshot.valid) {
+        SnapshotStore::instance().scheduleSave(m_Id);
+    }
+
     // 시작 시 홈 페이지 표시
     showHomePage();
 }
@@ -89,6 +103,98 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
+void MainWindow::addPage(QWidget *page, const QString &name, qint64 createMs)
+{
+    ui->stackedWidget->addWidget(page);
+    StartupTrace::span(QString("page.%1.created").arg(name), createMs);
+}
+
+SchedulePage *MainWindow::schedulePage()
+{
+    if (!m_schedulePage) {
+        QElapsedTimer createTimer;
+        createTimer.start();
+        m_schedulePage = new SchedulePage(m_Id, this);
+        addPage(m_schedulePage, "schedule", createTimer.elapsed());
+        m_refreshScheduler->addPage(m_schedulePage, RefreshScheduler::Cheap,
+                                    [this]() { m_schedulePage->refresh(); });
+
+        // 설정 페이지가 먼저 만들어졌으면 테마 변경을 이어 줌 (반대 순서는 settingsPage() 에서)
+        if (m_settingsPage) {
+            connect(m_settingsPage, &SettingsPage::themeChanged,
+                    m_schedulePage, &SchedulePage::applyTheme);
+        }
+    }
+    return m_schedulePage;
+}
+
+StatisticsPage *MainWindow::statisticsPage()
+{
+    if (!m_statisticsPage) {
+        QElapsedTimer createTimer;
+        createTimer.start();
+        m_statisticsPage = new StatisticsPage(m_Id, this);
+        addPage(m_statisticsPage, "statistics", createTimer.elapsed());
+        m_refreshScheduler->addPage(m_statisticsPage, RefreshScheduler::Cheap,
+                                    [this]() { m_statisticsPage->markDirty(); });
+    }
+    return m_statisticsPage;
+}
+
+SettingsPage *MainWindow::settingsPage()
+{
+    if (!m_settingsPage) {
+        QElapsedTimer createTimer;
+        createTimer.start();
+        m_settingsPage = new SettingsPage(m_Id, this);
+        addPage(m_settingsPage, "settings", createTimer.elapsed());
+
+        connect(m_settingsPage, &SettingsPage::themeChanged,
+                this, [](bool isDark){
+                    qDebug() << "테마 변경됨:" << (isDark ? "다크모드" : "라이트모드");
+                });
+
+        connect(m_settingsPage, &SettingsPage::themeChanged,
+                m_homePage, &HomePage::applyTheme);
+
+        // 아직 없는 일정 페이지는 생성 시 저장된 테마를 읽으므로 있을 때만 연결
+        if (m_schedulePage) {
+            connect(m_settingsPage, &SettingsPage::themeChanged,
+                    m_schedulePage, &SchedulePage::applyTheme);
+        }
+
+        // 회원 탈퇴 시 로그아웃 처리
+        connect(m_settingsPage, &SettingsPage::logoutRequested,
+                this, &MainWindow::close);
+    }
+    return m_settingsPage;
+}
+
+void MainWindow::startPreconstruct()
+{
+    if (m_preconstructStarted) {
+        return;
+    }
+    m_preconstructStarted = true;
+    QTimer::singleShot(0, this, &MainWindow::preconstructNext);
+}
+
+void MainWindow::preconstructNext()
+{
+    // 한 번에 한 페이지씩 - 사이사이 이벤트 처리가 끼어들어 입력이 밀리지 않도록
+    if (!m_schedulePage) {
+        schedulePage();
+    } else if (!m_statisticsPage) {
+        statisticsPage();
+    } else if (!m_settingsPage) {
+        settingsPage();
+    } else {
+        StartupTrace::mark("pages.preconstructed");
+        return;
+    }
+    QTimer::singleShot(0, this, &MainWindow::preconstructNext);
+}
+
 void MainWindow::showHomePage()
 {
     ui->stackedWidget->setCurrentWidget(m_homePage);
@@ -96,26 +202,40 @@ void MainWindow::showHomePage()
     // 버튼 상태 업데이트
     ui->homeButton->setChecked(true);
     ui->scheduleButton->setChecked(false);
+    ui->statisticsButton->setChecked(false);
     ui->settingsButton->setChecked(false);
 }
 
 void MainWindow::showSchedulePage()
 {
-    ui->stackedWidget->setCurrentWidget(m_schedulePage);
+    ui->stackedWidget->setCurrentWidget(schedulePage());
 
     // 버튼 상태 업데이트
     ui->homeButton->setChecked(false);
     ui->scheduleButton->setChecked(true);
+    ui->statisticsButton->setChecked(false);
+    ui->settingsButton->setChecked(false);
+}
+
+void MainWindow::showStatisticsPage()
+{
+    ui->stackedWidget->setCurrentWidget(statisticsPage());
+
+    // 버튼 상태 업데이트
+    ui->homeButton->setChecked(false);
+    ui->scheduleButton->setChecked(false);
+    ui->statisticsButton->setChecked(true);
     ui->settingsButton->setChecked(false);
 }
 
 void MainWindow::showSettingsPage()
 {
-    ui->stackedWidget->setCurrentWidget(m_settingsPage);
+    ui->stackedWidget->setCurrentWidget(settingsPage());
 
     // 버튼 상태 업데이트
     ui->homeButton->setChecked(false);
     ui->scheduleButton->setChecked(false);
+    ui->statisticsButton->setChecked(false);
     ui->settingsButton->setChecked(true);
 }
 
@@ -136,6 +256,10 @@ void MainWindow::closeEvent(QCloseEvent *event)
 {
     // 창 닫기전 로그아웃 처리
     m_isLogout = true;
+    // 아직 쓰지 않은 스냅샷 저장
+    SnapshotStore::instance().flush();
+    // 이 사용자를 위해 진행 중이던 AI 호출 중단 (다음 로그인 사용자의 요청을 늦추지 않도록)
+    AIService::instance().cancelAll();
     // main.cpp의 QEventLoop에 창이 닫혔다는 신호 전송
     emit windowClosed();
 
@@ -10,7 +10,10 @@ class MainWindow;
 
 class HomePage;
 class SchedulePage;
+class StatisticsPage;
 class SettingsPage;
+class DayScheduler;
+class RefreshScheduler;
 
 class MainWindow : public QMainWindow
 {
@@ -30,10 +33,19 @@ protected:
 private slots:
     void showHomePage();
     void showSchedulePage();
+    void showStatisticsPage();
     void showSettingsPage();
     void handleLogout();
 
 private:
+    // 홈 외의 페이지는 처음 이동할 때 만듦 (홈이 다 뜬 뒤 한가할 때 미리 만들 수도 있음)
+    SchedulePage *schedulePage();
+    StatisticsPage *statisticsPage();
+    SettingsPage *settingsPage();
+    void addPage(QWidget *page, const QString &name, qint64 createMs);
+    void startPreconstruct();
+    void preconstructNext();
+
     Ui::MainWindow *ui;
     int m_Id;
     QString m_userId;
@@ -41,10 +53,15 @@ private:
 
     bool m_isLogout = false;
 
-    // 페이지들
-    HomePage *m_homePage;
-    SchedulePage *m_schedulePage;
-    SettingsPage *m_settingsPage;
+    // 페이지들 (홈 외에는 만들기 전까지 nullptr)
+    HomePage *m_homePage = nullptr;
+    SchedulePage *m_schedulePage = nullptr;
+    StatisticsPage *m_statisticsPage = nullptr;
+    SettingsPage *m_settingsPage = nullptr;
+    bool m_preconstructStarted = false;
+
+    RefreshScheduler *m_refreshScheduler = nullptr;   // 일정 변경 시 보이는 페이지만 모아서 갱신
+    DayScheduler *m_dayScheduler;   // 자정 감지 + 다음 날 미리 생성
 };
 
 #endif // MAINWINDOW_H
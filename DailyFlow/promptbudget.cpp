@@ -0,0 +1,170 @@
+#include "promptbudget.h"
+#include <QStringList>
+
+namespace {
+
+const int kMaxMemoChars = 60;   // 1단계에서 남길 메모 길이
+
+// 프롬프트에 들어가는 일정 한 줄 (합쳐진 경우 count > 1)
+struct ScheduleLine {
+    QString startTime;
+    QString endTime;
+    QString title;
+    QString location;
+    QStringList memos;
+    int count = 1;
+};
+
+QString truncated(const QString &text, int maxChars)
+{
+    QString simplified = text.simplified();
+    if (simplified.size() <= maxChars) {
+        return simplified;
+    }
+    return simplified.left(maxChars) + "…";
+}
+
+QList<ScheduleLine> toLines(const QList<QVariantMap> &schedules)
+{
+    QList<ScheduleLine> lines;
+    lines.reserve(schedules.size());
+    for (const QVariantMap &schedule : schedules) {
+        ScheduleLine line;
+        line.startTime = schedule["startTime"].toString();
+        line.endTime = schedule["endTime"].toString();
+        line.title = schedule["title"].toString();
+        line.location = schedule["location"].toString();
+        QString memo = schedule["memo"].toString();
+        if (!memo.isEmpty()) {
+            line.memos.append(truncated(memo, kMaxMemoChars));
+        }
+        lines.append(line);
+    }
+    return lines;
+}
+
+// 시간순으로 이어지는 같은 제목/장소 일정을 하나로 (예: 반복되는 회의 블록)
+QList<ScheduleLine> mergeAdjacent(const QList<ScheduleLine> &lines)
+{
+    QList<ScheduleLine> merged;
+    for (const ScheduleLine &line : lines) {
+        if (!merged.isEmpty()) {
+            ScheduleLine &last = merged.last();
+            if (last.title.trimmed().compare(line.title.trimmed(), Qt::CaseInsensitive) == 0
+                && last.location == line.location) {
+                last.count += line.count;
+                if (!line.endTime.isEmpty()) {
+                    last.endTime = line.endTime;
+                }
+                for (const QString &memo : line.memos) {
+                    if (!last.memos.contains(memo)) {
+                        last.memos.append(memo);
+                    }
+                }
+                continue;
+            }
+        }
+        merged.append(line);
+    }
+    return merged;
+}
+
+QString renderLine(const ScheduleLine &line, bool withMemo)
+{
+    QString text = QString("- %1 %2").arg(line.startTime, line.title);
+    if (!line.location.isEmpty()) {
+        text += QString(" (%1)").arg(line.location);
+    }
+    if (!line.endTime.isEmpty()) {
+        text += QString(" ~ %1").arg(line.endTime);
+    }
+    if (line.count > 1) {
+        text += QString(" [%1건]").arg(line.count);
+    }
+    text += "\n";
+
+    if (withMemo && !line.memos.isEmpty()) {
+        text += QString("  메모: %1\n").arg(line.memos.join(" / "));
+    }
+    return text;
+}
+
+QString render(const QList<ScheduleLine> &lines, int total, const QString &dayLabel, bool withMemo)
+{
+    QString text = QString("%1은 총 %2개의 일정이 있습니다:\n").arg(dayLabel).arg(total);
+    for (const ScheduleLine &line : lines) {
+        text += renderLine(line, withMemo);
+    }
+    return text;
+}
+
+} // namespace
+
+namespace PromptBudget {
+
+int estimateTokens(const QString &text)
+{
+    int wide = 0;
+    int narrow = 0;
+    for (const QChar ch : text) {
+        ushort code = ch.unicode();
+        // 한글 음절/자모, CJK 한자는 대부분 글자당 1토큰 이상
+        if ((code >= 0xAC00 && code <= 0xD7A3) || (code >= 0x1100 && code <= 0x11FF)
+            || (code >= 0x3130 && code <= 0x318F) || (code >= 0x4E00 && code <= 0x9FFF)) {
+            wide++;
+        } else {
+            narrow++;
+        }
+    }
+    return wide + (narrow + 3) / 4;
+}
+
+QString compactSchedules(const QList<QVariantMap> &schedules, const QString &dayLabel, int tokenBudget)
+{
+    if (schedules.isEmpty()) {
+        return QString("%1은 등록된 일정이 없습니다.").arg(dayLabel);
+    }
+
+    const int total = schedules.size();
+
+    // 1. 메모 길이 제한
+    QList<ScheduleLine> lines = toLines(schedules);
+    QString text = render(lines, total, dayLabel, true);
+    if (estimateTokens(text) <= tokenBudget) {
+        return text;
+    }
+
+    // 2. 이어지는 비슷한 일정 합치기
+    lines = mergeAdjacent(lines);
+    text = render(lines, total, dayLabel, true);
+    if (estimateTokens(text) <= tokenBudget) {
+        return text;
+    }
+
+    // 3. 메모 생략
+    text = render(lines, total, dayLabel, false);
+    if (estimateTokens(text) <= tokenBudget) {
+        return text;
+    }
+
+    // 4. 예산 안에 들어가는 앞쪽 일정만 남김 (시간순이므로 이른 일정 우선)
+    text = QString("%1은 총 %2개의 일정이 있습니다:\n").arg(dayLabel).arg(total);
+    int used = estimateTokens(text);
+    int shown = 0;
+    for (const ScheduleLine &line : lines) {
+        QString rendered = renderLine(line, false);
+        int cost = estimateTokens(rendered);
+        if (used + cost > tokenBudget) {
+            break;
+        }
+        text += rendered;
+        used += cost;
+        shown += line.count;
+    }
+    if (shown < total) {
+        text += QString("- 외 %1개 일정\n").arg(total - shown);
+    }
+    return text;
+}
+
+} // namespace PromptBudget
@@ -0,0 +1,23 @@
+#ifndef PROMPTBUDGET_H
+#define PROMPTBUDGET_H
+
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+
+// 프롬프트 크기를 일정 개수와 무관하게 제한하기 위한 토큰 추정/압축 함수 모음
+namespace PromptBudget {
+
+// 대략적인 토큰 수 추정 (한글/한자는 글자당 1토큰, 그 외는 4글자당 1토큰)
+int estimateTokens(const QString &text);
+
+// 일정 목록을 프롬프트용 문장으로 만들되 tokenBudget 을 넘지 않도록 단계적으로 줄임
+//   1. 메모는 앞부분만 남김
+//   2. 연속된 같은 제목/장소 일정은 한 줄로 합침
+//   3. 그래도 넘치면 메모를 모두 생략
+//   4. 그래도 넘치면 앞쪽 일정만 남기고 "외 N개" 로 표시
+QString compactSchedules(const QList<QVariantMap> &schedules, const QString &dayLabel, int tokenBudget);
+
+} // namespace PromptBudget
+
+#endif // PROMPTBUDGET_H
@@ -0,0 +1,94 @@
+#include "refreshscheduler.h"
+#include "datamanager.h"
+#include "envloader.h"
+#include "aimetrics.h"
+#include <QEvent>
+#include <QTimer>
+#include <QDebug>
+
+RefreshScheduler::RefreshScheduler(int userId, QObject *parent)
+    : QObject(parent)
+    , m_userId(userId)
+    , m_frameTimer(new QTimer(this))
+    , m_settleTimer(new QTimer(this))
+{
+    m_frameTimer->setSingleShot(true);
+    m_frameTimer->setInterval(16);
+    connect(m_frameTimer, &QTimer::timeout, this, [this]() { flush(Cheap); });
+
+    m_settleTimer->setSingleShot(true);
+    m_settleTimer->setInterval(EnvLoader::get("AI_REFRESH_DEBOUNCE_MS", "1500").toInt());
+    connect(m_settleTimer, &QTimer::timeout, this, [this]() { flush(Expensive); });
+
+    connect(&DataManager::instance(), &DataManager::scheduleChanged,
+            this, [this](int userId) {
+                if (userId == m_userId) {
+                    markDirty();
+                }
+            });
+}
+
+void RefreshScheduler::addPage(QWidget *page, Cost cost, std::function<void()> refresh)
+{
+    Target target;
+    target.page = page;
+    target.cost = cost;
+    target.refresh = std::move(refresh);
+    m_targets.append(target);
+    page->installEventFilter(this);
+}
+
+void RefreshScheduler::markDirty()
+{
+    AIMetrics::instance().increment("refresh.requests");
+    for (Target &target : m_targets) {
+        target.dirty = true;
+    }
+    // 프레임 타이머는 이미 돌고 있으면 그대로 두고 (첫 변경 기준 한 프레임 안에 반영)
+    // 비싼 작업은 변경이 들어올 때마다 다시 기다림
+    if (!m_frameTimer->isActive()) {
+        m_frameTimer->start();
+    }
+    m_settleTimer->start();
+}
+
+void RefreshScheduler::flush(Cost cost)
+{
+    for (int i = 0; i < m_targets.size(); ++i) {
+        Target &target = m_targets[i];
+        if (!target.page) {
+            m_targets.removeAt(i--);
+            continue;
+        }
+        if (target.cost != cost || !target.dirty || !target.page->isVisible()) {
+            continue;
+        }
+        target.dirty = false;
+        AIMetrics::instance().increment(cost == Cheap ? "refresh.cheap_runs" : "refresh.expensive_runs");
+        target.refresh();
+    }
+}
+
+bool RefreshScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Show) {
+        // 숨겨져 있던 동안 밀린 갱신은 페이지가 다 보인 뒤에 실행
+        // 비싼 작업도 아직 수정이 이어지는 중이면 잠잠해질 때까지 기다림
+        QTimer::singleShot(0, this, [this, page = QPointer<QObject>(watched)]() {
+            if (!page) {
+                return;
+            }
+            for (Target &target : m_targets) {
+                if (target.page.data() != page.data() || !target.dirty || !target.page->isVisible()) {
+                    continue;
+                }
+                if (target.cost == Expensive && m_settleTimer->isActive()) {
+                    continue;
+                }
+                target.dirty = false;
+                target.refresh();
+            }
+        });
+    }
+    return QObject::eventFilter(watched, event);
+}
@@ -0,0 +1,53 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+#include <QWidget>
+#include <functional>
+
+class QTimer;
+
+// 일정 변경 알림을 모아서 화면 갱신을 한 번으로 줄이는 스케줄러
+// - 한 프레임(16ms) 안에 들어온 변경은 한 번의 갱신으로 처리
+// - 보이는 페이지만 바로 갱신하고, 숨겨진 페이지는 표시해 둔 뒤 보일 때 갱신
+// - AI 요약처럼 비싼 작업은 수정이 잠잠해진 뒤(AI_REFRESH_DEBOUNCE_MS, 기본 1500ms)에만 실행
+class RefreshScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Cost {
+        Cheap,       // DB 조회와 다시 그리기 - 다음 프레임에 실행
+        Expensive    // 네트워크/AI 호출 - 변경이 멈춘 뒤 실행
+    };
+
+    explicit RefreshScheduler(int userId, QObject *parent = nullptr);
+
+    // page 가 보일 때 refresh 를 실행하도록 등록 (page 가 사라지면 자동으로 제외)
+    void addPage(QWidget *page, Cost cost, std::function<void()> refresh);
+
+public slots:
+    void markDirty();   // 등록된 모든 갱신을 예약
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Target {
+        QPointer<QWidget> page;
+        Cost cost;
+        std::function<void()> refresh;
+        bool dirty = false;
+    };
+
+    void flush(Cost cost);
+
+    int m_userId;
+    QList<Target> m_targets;
+    QTimer *m_frameTimer;
+    QTimer *m_settleTimer;
+};
+
+#endif // REFRESHSCHEDULER_H
@@ -0,0 +1,262 @@
+#include "regionresolver.h"
+#include <QByteArray>
+#include <QStringList>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+struct Region {
+    const char *key;      // "시도|시군구" (UTF-8), 시/도 대표 좌표는 "시도|"
+    double latitude;
+    double longitude;
+};
+
+// 시/도 표기 변형 → 표의 시/도 약칭
+struct SidoAlias {
+    const char *key;
+    const char *sido;
+};
+
+// 좌표는 각 시/도청, 시/군/구청 부근 (소수점 둘째 자리면 날씨 조회에 충분)
+constexpr Region kRegions[] = {
+    {"서울|", 37.5665, 126.9780},
+    {"부산|", 35.1796, 129.0756},
+    {"대구|", 35.8714, 128.6014},
+    {"인천|", 37.4563, 126.7052},
+    {"광주|", 35.1595, 126.8526},
+    {"대전|", 36.3504, 127.3845},
+    {"울산|", 35.5384, 129.3114},
+    {"세종|", 36.4800, 127.2890},
+    {"경기|", 37.2752, 127.0095},
+    {"강원|", 37.8813, 127.7298},
+    {"충북|", 36.6357, 127.4917},
+    {"충남|", 36.6588, 126.6728},
+    {"전북|", 35.8202, 127.1088},
+    {"전남|", 34.8161, 126.4629},
+    {"경북|", 36.5760, 128.5056},
+    {"경남|", 35.2383, 128.6924},
+    {"제주|", 33.4890, 126.4983},
+    // 서울
+    {"서울|종로구", 37.57, 126.98}, {"서울|중구", 37.56, 127.00}, {"서울|용산구", 37.53, 126.98},
+    {"서울|성동구", 37.56, 127.04}, {"서울|광진구", 37.54, 127.08}, {"서울|동대문구", 37.57, 127.04},
+    {"서울|중랑구", 37.61, 127.09}, {"서울|성북구", 37.59, 127.02}, {"서울|강북구", 37.64, 127.03},
+    {"서울|도봉구", 37.67, 127.05}, {"서울|노원구", 37.65, 127.06}, {"서울|은평구", 37.60, 126.93},
+    {"서울|서대문구", 37.58, 126.94}, {"서울|마포구", 37.57, 126.90}, {"서울|양천구", 37.52, 126.87},
+    {"서울|강서구", 37.55, 126.85}, {"서울|구로구", 37.50, 126.89}, {"서울|금천구", 37.46, 126.90},
+    {"서울|영등포구", 37.53, 126.90}, {"서울|동작구", 37.51, 126.94}, {"서울|관악구", 37.48, 126.95},
+    {"서울|서초구", 37.48, 127.03}, {"서울|강남구", 37.52, 127.05}, {"서울|송파구", 37.51, 127.11},
+    {"서울|강동구", 37.53, 127.12},
+    // 부산
+    {"부산|중구", 35.11, 129.03}, {"부산|서구", 35.10, 129.02}, {"부산|동구", 35.13, 129.05},
+    {"부산|영도구", 35.09, 129.07}, {"부산|부산진구", 35.16, 129.05}, {"부산|동래구", 35.20, 129.09},
+    {"부산|남구", 35.14, 129.08}, {"부산|북구", 35.20, 128.99}, {"부산|해운대구", 35.16, 129.16},
+    {"부산|사하구", 35.10, 128.97}, {"부산|금정구", 35.24, 129.09}, {"부산|강서구", 35.21, 128.98},
+    {"부산|연제구", 35.18, 129.08}, {"부산|수영구", 35.15, 129.11}, {"부산|사상구", 35.15, 128.99},
+    {"부산|기장군", 35.24, 129.22},
+    // 대구
+    {"대구|중구", 35.87, 128.61}, {"대구|동구", 35.89, 128.64}, {"대구|서구", 35.87, 128.56},
+    {"대구|남구", 35.85, 128.60}, {"대구|북구", 35.89, 128.58}, {"대구|수성구", 35.86, 128.63},
+    {"대구|달서구", 35.83, 128.53}, {"대구|달성군", 35.77, 128.43}, {"대구|군위군", 36.24, 128.57},
+    // 인천
+    {"인천|중구", 37.47, 126.62}, {"인천|동구", 37.47, 126.64}, {"인천|미추홀구", 37.46, 126.65},
+    {"인천|연수구", 37.41, 126.68}, {"인천|남동구", 37.45, 126.73}, {"인천|부평구", 37.51, 126.72},
+    {"인천|계양구", 37.54, 126.74}, {"인천|서구", 37.55, 126.68}, {"인천|강화군", 37.75, 126.49},
+    {"인천|옹진군", 37.45, 126.64},
+    // 광주
+    {"광주|동구", 35.15, 126.92}, {"광주|서구", 35.15, 126.89}, {"광주|남구", 35.13, 126.90},
+    {"광주|북구", 35.17, 126.91}, {"광주|광산구", 35.14, 126.79},
+    // 대전
+    {"대전|동구", 36.31, 127.45}, {"대전|중구", 36.33, 127.42}, {"대전|서구", 36.36, 127.38},
+    {"대전|유성구", 36.36, 127.36}, {"대전|대덕구", 36.35, 127.42},
+    // 울산
+    {"울산|중구", 35.57, 129.33}, {"울산|남구", 35.54, 129.33}, {"울산|동구", 35.50, 129.42},
+    {"울산|북구", 35.58, 129.36}, {"울산|울주군", 35.56, 129.24},
+    // 경기
+    {"경기|수원시", 37.26, 127.03}, {"경기|성남시", 37.42, 127.13}, {"경기|의정부시", 37.74, 127.03},
+    {"경기|안양시", 37.39, 126.93}, {"경기|부천시", 37.50, 126.77}, {"경기|광명시", 37.48, 126.86},
+    {"경기|평택시", 36.99, 127.11}, {"경기|동두천시", 37.90, 127.06}, {"경기|안산시", 37.32, 126.83},
+    {"경기|고양시", 37.66, 126.83}, {"경기|과천시", 37.43, 126.99}, {"경기|구리시", 37.59, 127.13},
+    {"경기|남양주시", 37.64, 127.22}, {"경기|오산시", 37.15, 127.08}, {"경기|시흥시", 37.38, 126.80},
+    {"경기|군포시", 37.36, 126.94}, {"경기|의왕시", 37.34, 126.97}, {"경기|하남시", 37.54, 127.21},
+    {"경기|용인시", 37.24, 127.18}, {"경기|파주시", 37.76, 126.78}, {"경기|이천시", 37.27, 127.44},
+    {"경기|안성시", 37.01, 127.28}, {"경기|김포시", 37.62, 126.72}, {"경기|화성시", 37.20, 126.83},
+    {"경기|광주시", 37.43, 127.26}, {"경기|양주시", 37.79, 127.05}, {"경기|포천시", 37.89, 127.20},
+    {"경기|여주시", 37.30, 127.64}, {"경기|연천군", 38.10, 127.07}, {"경기|가평군", 37.83, 127.51},
+    {"경기|양평군", 37.49, 127.49},
+    // 강원
+    {"강원|춘천시", 37.88, 127.73}, {"강원|원주시", 37.34, 127.92}, {"강원|강릉시", 37.75, 128.88},
+    {"강원|동해시", 37.52, 129.11}, {"강원|태백시", 37.16, 128.99}, {"강원|속초시", 38.21, 128.59},
+    {"강원|삼척시", 37.45, 129.17}, {"강원|홍천군", 37.70, 127.89}, {"강원|횡성군", 37.49, 127.99},
+    {"강원|영월군", 37.18, 128.46}, {"강원|평창군", 37.37, 128.39}, {"강원|정선군", 37.38, 128.66},
+    {"강원|철원군", 38.15, 127.31}, {"강원|화천군", 38.11, 127.71}, {"강원|양구군", 38.11, 127.99},
+    {"강원|인제군", 38.07, 128.17}, {"강원|고성군", 38.38, 128.47}, {"강원|양양군", 38.08, 128.62},
+    // 충북
+    {"충북|청주시", 36.64, 127.49}, {"충북|충주시", 36.99, 127.93}, {"충북|제천시", 37.13, 128.19},
+    {"충북|보은군", 36.49, 127.73}, {"충북|옥천군", 36.31, 127.57}, {"충북|영동군", 36.18, 127.78},
+    {"충북|증평군", 36.79, 127.58}, {"충북|진천군", 36.86, 127.44}, {"충북|괴산군", 36.82, 127.79},
+    {"충북|음성군", 36.94, 127.69}, {"충북|단양군", 36.98, 128.37},
+    // 충남
+    {"충남|천안시", 36.81, 127.11}, {"충남|공주시", 36.45, 127.12}, {"충남|보령시", 36.33, 126.61},
+    {"충남|아산시", 36.79, 127.00}, {"충남|서산시", 36.78, 126.45}, {"충남|논산시", 36.19, 127.10},
+    {"충남|계룡시", 36.27, 127.25}, {"충남|당진시", 36.89, 126.63}, {"충남|금산군", 36.11, 127.49},
+    {"충남|부여군", 36.28, 126.91}, {"충남|서천군", 36.08, 126.69}, {"충남|청양군", 36.46, 126.80},
+    {"충남|홍성군", 36.60, 126.66}, {"충남|예산군", 36.68, 126.85}, {"충남|태안군", 36.75, 126.30},
+    // 전북
+    {"전북|전주시", 35.82, 127.15}, {"전북|군산시", 35.97, 126.74}, {"전북|익산시", 35.95, 126.96},
+    {"전북|정읍시", 35.57, 126.86}, {"전북|남원시", 35.42, 127.39}, {"전북|김제시", 35.80, 126.88},
+    {"전북|완주군", 35.90, 127.16}, {"전북|진안군", 35.79, 127.42}, {"전북|무주군", 36.01, 127.66},
+    {"전북|장수군", 35.65, 127.52}, {"전북|임실군", 35.62, 127.29}, {"전북|순창군", 35.37, 127.14},
+    {"전북|고창군", 35.44, 126.70}, {"전북|부안군", 35.73, 126.73},
+    // 전남
+    {"전남|목포시", 34.81, 126.39}, {"전남|여수시", 34.76, 127.66}, {"전남|순천시", 34.95, 127.49},
+    {"전남|나주시", 35.02, 126.71}, {"전남|광양시", 34.94, 127.70}, {"전남|담양군", 35.32, 126.99},
+    {"전남|곡성군", 35.28, 127.29}, {"전남|구례군", 35.20, 127.46}, {"전남|고흥군", 34.61, 127.29},
+    {"전남|보성군", 34.77, 127.08}, {"전남|화순군", 35.06, 126.99}, {"전남|장흥군", 34.68, 126.91},
+    {"전남|강진군", 34.64, 126.77}, {"전남|해남군", 34.57, 126.60}, {"전남|영암군", 34.80, 126.70},
+    {"전남|무안군", 34.99, 126.48}, {"전남|함평군", 35.07, 126.52}, {"전남|영광군", 35.28, 126.51},
+    {"전남|장성군", 35.30, 126.78}, {"전남|완도군", 34.31, 126.76}, {"전남|진도군", 34.49, 126.26},
+    {"전남|신안군", 34.83, 126.35},
+    // 경북
+    {"경북|포항시", 36.02, 129.34}, {"경북|경주시", 35.86, 129.22}, {"경북|김천시", 36.14, 128.11},
+    {"경북|안동시", 36.57, 128.73}, {"경북|구미시", 36.12, 128.34}, {"경북|영주시", 36.81, 128.62},
+    {"경북|영천시", 35.97, 128.94}, {"경북|상주시", 36.41, 128.16}, {"경북|문경시", 36.59, 128.19},
+    {"경북|경산시", 35.83, 128.74}, {"경북|의성군", 36.35, 128.70}, {"경북|청송군", 36.44, 129.06},
+    {"경북|영양군", 36.67, 129.11}, {"경북|영덕군", 36.42, 129.37}, {"경북|청도군", 35.65, 128.73},
+    {"경북|고령군", 35.73, 128.26}, {"경북|성주군", 35.92, 128.28}, {"경북|칠곡군", 35.99, 128.40},
+    {"경북|예천군", 36.66, 128.45}, {"경북|봉화군", 36.89, 128.73}, {"경북|울진군", 36.99, 129.40},
+    {"경북|울릉군", 37.48, 130.91},
+    // 경남
+    {"경남|창원시", 35.23, 128.68}, {"경남|진주시", 35.18, 128.11}, {"경남|통영시", 34.85, 128.43},
+    {"경남|사천시", 35.00, 128.06}, {"경남|김해시", 35.23, 128.89}, {"경남|밀양시", 35.50, 128.75},
+    {"경남|거제시", 34.88, 128.62}, {"경남|양산시", 35.34, 129.04}, {"경남|의령군", 35.32, 128.26},
+    {"경남|함안군", 35.27, 128.41}, {"경남|창녕군", 35.54, 128.49}, {"경남|고성군", 34.97, 128.32},
+    {"경남|남해군", 34.84, 127.89}, {"경남|하동군", 35.07, 127.75}, {"경남|산청군", 35.42, 127.87},
+    {"경남|함양군", 35.52, 127.73}, {"경남|거창군", 35.69, 127.91}, {"경남|합천군", 35.57, 128.17},
+    // 제주
+    {"제주|제주시", 33.50, 126.53}, {"제주|서귀포시", 33.25, 126.56},
+};
+
+constexpr SidoAlias kSidoAliases[] = {
+    {"서울특별시", "서울"}, {"서울시", "서울"}, {"서울", "서울"}, {"부산광역시", "부산"},
+    {"부산시", "부산"}, {"부산", "부산"}, {"대구광역시", "대구"}, {"대구시", "대구"},
+    {"대구", "대구"}, {"인천광역시", "인천"}, {"인천시", "인천"}, {"인천", "인천"},
+    {"광주광역시", "광주"}, {"광주", "광주"}, {"대전광역시", "대전"}, {"대전시", "대전"},
+    {"대전", "대전"}, {"울산광역시", "울산"}, {"울산시", "울산"}, {"울산", "울산"},
+    {"세종특별자치시", "세종"}, {"세종시", "세종"}, {"세종", "세종"}, {"경기도", "경기"},
+    {"경기", "경기"}, {"강원특별자치도", "강원"}, {"강원도", "강원"}, {"강원", "강원"},
+    {"충청북도", "충북"}, {"충북", "충북"}, {"충청남도", "충남"}, {"충남", "충남"},
+    {"전북특별자치도", "전북"}, {"전라북도", "전북"}, {"전북", "전북"}, {"전라남도", "전남"},
+    {"전남", "전남"}, {"경상북도", "경북"}, {"경북", "경북"}, {"경상남도", "경남"},
+    {"경남", "경남"}, {"제주특별자치도", "제주"}, {"제주도", "제주"}, {"제주", "제주"},
+};
+
+constexpr std::uint32_t fnv1a(const char *text)
+{
+    std::uint32_t hash = 2166136261u;
+    while (*text) {
+        hash ^= static_cast<unsigned char>(*text++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// 선형 탐사 해시 색인 - 빈 칸은 -1, 각 칸은 원본 배열의 인덱스
+template <std::size_t Size>
+struct HashIndex {
+    std::array<std::int16_t, Size> slots{};
+    int maxProbe = 0;
+};
+
+template <std::size_t Size, typename Entry, std::size_t N>
+constexpr HashIndex<Size> buildIndex(const Entry (&entries)[N])
+{
+    static_assert((Size & (Size - 1)) == 0, "index size must be a power of two");
+    static_assert(N < Size / 2, "index load factor must stay below 0.5");
+
+    HashIndex<Size> index;
+    for (std::size_t slot = 0; slot < Size; ++slot) {
+        index.slots[slot] = -1;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t slot = fnv1a(entries[i].key) & (Size - 1);
+        int probe = 0;
+        while (index.slots[slot] != -1) {
+            slot = (slot + 1) & (Size - 1);
+            ++probe;
+        }
+        index.slots[slot] = static_cast<std::int16_t>(i);
+        if (probe > index.maxProbe) {
+            index.maxProbe = probe;
+        }
+    }
+    return index;
+}
+
+constexpr auto kRegionIndex = buildIndex<1024>(kRegions);
+constexpr auto kSidoAliasIndex = buildIndex<128>(kSidoAliases);
+
+// 표를 고치다가 충돌이 몰리면 빌드에서 바로 알 수 있도록
+static_assert(kRegionIndex.maxProbe <= 4, "region index probe length grew, enlarge the index");
+static_assert(kSidoAliasIndex.maxProbe <= 4, "alias index probe length grew, enlarge the index");
+
+template <std::size_t Size, typename Entry, std::size_t N>
+const Entry *find(const HashIndex<Size> &index, const Entry (&entries)[N], const QByteArray &key)
+{
+    std::size_t slot = fnv1a(key.constData()) & (Size - 1);
+    for (int probe = 0; probe <= index.maxProbe; ++probe) {
+        std::int16_t i = index.slots[slot];
+        if (i == -1) {
+            return nullptr;
+        }
+        if (std::strcmp(entries[i].key, key.constData()) == 0) {
+            return &entries[i];
+        }
+        slot = (slot + 1) & (Size - 1);
+    }
+    return nullptr;
+}
+
+RegionLocation toLocation(const Region &region)
+{
+    RegionLocation location;
+    location.key = QString::fromUtf8(region.key);
+    location.latitude = region.latitude;
+    location.longitude = region.longitude;
+    return location;
+}
+
+} // namespace
+
+namespace RegionResolver {
+
+RegionLocation resolve(const QString &address)
+{
+    const Region &seoul = kRegions[0];
+    QStringList parts = address.simplified().split(' ', Qt::SkipEmptyParts);
+    if (parts.isEmpty()) {
+        return toLocation(seoul);
+    }
+
+    // 1. 시/도 ("경기도", "경기", "서울특별시" ...)
+    const SidoAlias *alias = find(kSidoAliasIndex, kSidoAliases, parts[0].toUtf8());
+    if (!alias) {
+        return toLocation(seoul);
+    }
+    QByteArray sido = QByteArray(alias->sido) + '|';
+
+    // 2. 시/군/구 (일반구가 있는 시는 시 단위로 등록되어 있음: "성남시 분당구" → 성남시)
+    if (parts.size() > 1) {
+        const Region *region = find(kRegionIndex, kRegions, sido + parts[1].toUtf8());
+        if (region) {
+            return toLocation(*region);
+        }
+    }
+
+    // 3. 시/도 대표 좌표 (세종처럼 하위 행정구역이 없는 경우 포함)
+    const Region *center = find(kRegionIndex, kRegions, sido);
+    return center ? toLocation(*center) : toLocation(seoul);
+}
+
+} // namespace RegionResolver
@@ -0,0 +1,24 @@
+#ifndef REGIONRESOLVER_H
+#define REGIONRESOLVER_H
+
+#include <QString>
+
+// 주소에서 찾은 지역과 좌표
+struct RegionLocation {
+    QString key;             // "시도|시군구" 또는 "시도|" (날씨 캐시 키로도 사용)
+    double latitude = 0.0;
+    double longitude = 0.0;
+};
+
+// 한국 주소 → 시/도, 시/군/구 좌표
+// 전체 시/도와 시/군/구 표는 컴파일 시간에 FNV-1a 해시 표로 만들어지므로
+// 조회는 문자열 해시 한 번과 상수 횟수 이하의 비교로 끝남
+namespace RegionResolver {
+
+// "경기도 성남시 분당구 ..." → 경기|성남시
+// 시/군/구를 찾지 못하면 시/도 대표 좌표, 시/도도 모르면 서울
+RegionLocation resolve(const QString &address);
+
+} // namespace RegionResolver
+
+#endif // REGIONRESOLVER_H
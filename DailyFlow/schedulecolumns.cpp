@@ -0,0 +1,191 @@
+#include "schedulecolumns.h"
+#include <QHash>
+#include <algorithm>
+
+// ============================================================================
+// ScheduleColumns
+// ============================================================================
+
+void ScheduleColumns::reserve(int count)
+{
+    dayNumbers.reserve(count);
+    startMinutes.reserve(count);
+    endMinutes.reserve(count);
+    categoryIds.reserve(count);
+    titleOffsets.reserve(count + 1);
+}
+
+void ScheduleColumns::append(qint32 dayNumber, qint16 startMinute, qint16 endMinute,
+                             const QString &category, const QString &title)
+{
+    if (titleOffsets.isEmpty()) {
+        titleOffsets.append(0);
+    }
+
+    dayNumbers.append(dayNumber);
+    startMinutes.append(startMinute);
+    endMinutes.append(endMinute);
+    categoryIds.append(static_cast<quint8>(categoryId(category)));
+
+    titleArena.append(title.toUtf8());
+    titleOffsets.append(static_cast<quint32>(titleArena.size()));
+}
+
+QString ScheduleColumns::title(int index) const
+{
+    if (index < 0 || index >= size()) {
+        return QString();
+    }
+    quint32 begin = titleOffsets[index];
+    quint32 end = titleOffsets[index + 1];
+    return QString::fromUtf8(titleArena.constData() + begin, end - begin);
+}
+
+int ScheduleColumns::categoryId(const QString &category)
+{
+    int id = categories.indexOf(category);
+    if (id < 0) {
+        // quint8 로 저장하므로 255개를 넘는 카테고리는 마지막 칸으로 합침
+        if (categories.size() >= 255) {
+            return 254;
+        }
+        categories.append(category);
+        id = categories.size() - 1;
+    }
+    return id;
+}
+
+// ============================================================================
+// 집계 함수
+// ============================================================================
+
+namespace ScheduleStats {
+
+QVector<qint32> durations(const ScheduleColumns &columns)
+{
+    const int n = columns.size();
+    QVector<qint32> result(n);
+
+    const qint16 *start = columns.startMinutes.constData();
+    const qint16 *end = columns.endMinutes.constData();
+    qint32 *out = result.data();
+
+    // 분기 없는 단순 루프 - 컴파일러 자동 벡터화 대상
+    for (int i = 0; i < n; ++i) {
+        out[i] = std::max<qint32>(0, qint32(end[i]) - qint32(start[i]));
+    }
+    return result;
+}
+
+QVector<qint32> countPerCategory(const ScheduleColumns &columns)
+{
+    QVector<qint32> result(columns.categories.size(), 0);
+    const quint8 *category = columns.categoryIds.constData();
+    qint32 *out = result.data();
+
+    for (int i = 0, n = columns.size(); i < n; ++i) {
+        out[category[i]]++;
+    }
+    return result;
+}
+
+QVector<qint64> minutesPerCategory(const ScheduleColumns &columns, const QVector<qint32> &durations)
+{
+    QVector<qint64> result(columns.categories.size(), 0);
+    const quint8 *category = columns.categoryIds.constData();
+    const qint32 *minutes = durations.constData();
+    qint64 *out = result.data();
+
+    for (int i = 0, n = columns.size(); i < n; ++i) {
+        out[category[i]] += minutes[i];
+    }
+    return result;
+}
+
+QVector<qint32> countPerWeekday(const ScheduleColumns &columns)
+{
+    QVector<qint32> result(7, 0);
+    const qint32 *day = columns.dayNumbers.constData();
+    qint32 *out = result.data();
+
+    // Julian day 0 은 월요일 - QDate::dayOfWeek() 와 같은 계산
+    for (int i = 0, n = columns.size(); i < n; ++i) {
+        out[day[i] % 7]++;
+    }
+    return result;
+}
+
+QVector<qint32> countPerStartHour(const ScheduleColumns &columns)
+{
+    QVector<qint32> result(24, 0);
+    const qint16 *start = columns.startMinutes.constData();
+    qint32 *out = result.data();
+
+    for (int i = 0, n = columns.size(); i < n; ++i) {
+        out[std::clamp(start[i] / 60, 0, 23)]++;
+    }
+    return result;
+}
+
+QVector<qint64> minutesPerWeekAndCategory(const ScheduleColumns &columns,
+                                          const QVector<qint32> &durations,
+                                          qint32 firstDay, int weeks)
+{
+    const int categoryCount = columns.categories.size();
+    QVector<qint64> result(weeks * categoryCount, 0);
+    if (weeks <= 0 || categoryCount == 0) {
+        return result;
+    }
+
+    const qint32 *day = columns.dayNumbers.constData();
+    const quint8 *category = columns.categoryIds.constData();
+    const qint32 *minutes = durations.constData();
+    qint64 *out = result.data();
+
+    for (int i = 0, n = columns.size(); i < n; ++i) {
+        int week = std::clamp((day[i] - firstDay) / 7, 0, weeks - 1);
+        out[week * categoryCount + category[i]] += minutes[i];
+    }
+    return result;
+}
+
+QVector<QList<TitleCount>> topTitlesPerCategory(const ScheduleColumns &columns, int limit)
+{
+    const int categoryCount = columns.categories.size();
+    QVector<QList<TitleCount>> result(categoryCount);
+    if (columns.isEmpty() || limit <= 0) {
+        return result;
+    }
+
+    // 키는 titleArena 를 복사하지 않고 가리키기만 함 (columns 가 살아 있는 동안만 유효)
+    QVector<QHash<QByteArray, qint32>> counts(categoryCount);
+    const char *arena = columns.titleArena.constData();
+    const quint32 *offsets = columns.titleOffsets.constData();
+    const quint8 *category = columns.categoryIds.constData();
+    for (int i = 0, n = columns.size(); i < n; ++i) {
+        if (offsets[i + 1] == offsets[i]) {
+            continue;
+        }
+        counts[category[i]][QByteArray::fromRawData(arena + offsets[i], offsets[i + 1] - offsets[i])]++;
+    }
+
+    for (int c = 0; c < categoryCount; ++c) {
+        QList<QPair<qint32, QByteArray>> ranked;
+        ranked.reserve(counts[c].size());
+        for (auto it = counts[c].cbegin(); it != counts[c].cend(); ++it) {
+            ranked.append({it.value(), it.key()});
+        }
+        int top = std::min<int>(limit, ranked.size());
+        // 개수 내림차순, 같으면 제목 순으로 고정
+        std::partial_sort(ranked.begin(), ranked.begin() + top, ranked.end(),
+                          [](const QPair<qint32, QByteArray> &a, const QPair<qint32, QByteArray> &b) {
+                              return a.first != b.first ? a.first > b.first : a.second < b.second;
+                          });
+        for (int i = 0; i < top; ++i) {
+            result[c].append({QString::fromUtf8(ranked[i].second), ranked[i].first});
+        }
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,64 @@
+#ifndef SCHEDULECOLUMNS_H
+#define SCHEDULECOLUMNS_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 통계/분석용 열 기반(structure-of-arrays) 일정 묶음
+// QList<QVariantMap> 대신 같은 종류의 값을 연속된 배열에 담아 집계 루프가 벡터화되도록 함
+struct ScheduleColumns
+{
+    QVector<qint32> dayNumbers;     // QDate::toJulianDay()
+    QVector<qint16> startMinutes;   // 00:00 기준 분
+    QVector<qint16> endMinutes;     // 종료 시간이 없으면 시작 시간과 같음
+    QVector<quint8> categoryIds;    // categories 의 인덱스
+    QVector<quint32> titleOffsets;  // titleArena 안의 시작 위치 (size() + 1 개)
+    QByteArray titleArena;          // 모든 제목을 UTF-8로 이어 붙인 버퍼
+    QStringList categories;         // 카테고리 사전
+
+    int size() const { return dayNumbers.size(); }
+    bool isEmpty() const { return dayNumbers.isEmpty(); }
+
+    void reserve(int count);
+    void append(qint32 dayNumber, qint16 startMinute, qint16 endMinute,
+                const QString &category, const QString &title);
+    QString title(int index) const;
+    int categoryId(const QString &category);
+};
+
+// ScheduleColumns 위에서 동작하는 집계 함수 모음
+namespace ScheduleStats {
+
+// 일정별 소요 시간(분), 음수는 0으로 처리
+QVector<qint32> durations(const ScheduleColumns &columns);
+
+// 카테고리별 일정 개수 / 총 소요 시간(분)
+QVector<qint32> countPerCategory(const ScheduleColumns &columns);
+QVector<qint64> minutesPerCategory(const ScheduleColumns &columns, const QVector<qint32> &durations);
+
+// 요일별 일정 개수 (0 = 월요일 ... 6 = 일요일)
+QVector<qint32> countPerWeekday(const ScheduleColumns &columns);
+
+// 시작 시각(0~23시)별 일정 개수
+QVector<qint32> countPerStartHour(const ScheduleColumns &columns);
+
+// 주차 x 카테고리 소요 시간(분) 행렬, [week * categories.size() + categoryId]
+// firstDay 는 첫 주의 시작일(Julian day)
+QVector<qint64> minutesPerWeekAndCategory(const ScheduleColumns &columns,
+                                          const QVector<qint32> &durations,
+                                          qint32 firstDay, int weeks);
+
+// 카테고리별로 가장 자주 쓰인 제목 (많은 순, 카테고리마다 최대 limit 개)
+// 제목은 titleArena 의 바이트 구간으로 세고 고른 것만 QString 으로 변환
+struct TitleCount {
+    QString title;
+    qint32 count = 0;
+};
+QVector<QList<TitleCount>> topTitlesPerCategory(const ScheduleColumns &columns, int limit);
+
+}
+
+#endif // SCHEDULECOLUMNS_H
@@ -2,9 +2,11 @@
 #include "ui_schedulepage.h"
 #include "scheduledialog.h"
 #include "datamanager.h"
+#include "snapshotstore.h"
 #include <QMessageBox>
 #include <QScrollArea>
 #include <QSettings>
+#include <QTimer>
 
 // ============================================================================
 // CustomCalendar 구현 (변경 없음)
@@ -372,12 +374,18 @@ SchedulePage::SchedulePage(int userId, QWidget *parent)
     bool isDarkMode = settings.value("darkMode", false).toBool();
     applyTheme(isDarkMode);
 
-    // 초기 데이터 로드
-    updateCalendarSchedules();
-    loadSchedulesForDate(m_selectedDate);
+    // 캘린더 표시는 스냅샷의 이번 달 일정 개수로 먼저 그림
+    const SnapshotStore::Snapshot &snapshot = SnapshotStore::instance().snapshot(m_userId);
+    if (snapshot.valid && snapshot.year == m_calendar->yearShown() &&
+        snapshot.month == m_calendar->monthShown()) {
+        m_calendar->setScheduleDates(snapshot.monthCounts);
+    }
 
-    // 날짜 라벨 초기화
-    onDateSelected(m_selectedDate);
+    // 실제 DB 조회는 창이 뜬 뒤에 수행 (날짜 라벨 초기화 포함)
+    QTimer::singleShot(0, this, [this]() {
+        updateCalendarSchedules();
+        onDateSelected(m_selectedDate);
+    });
 }
 
 SchedulePage::~SchedulePage()
@@ -385,6 +393,12 @@ SchedulePage::~SchedulePage()
     delete ui;
 }
 
+void SchedulePage::refresh()
+{
+    updateCalendarSchedules();
+    loadSchedulesForDate(m_selectedDate);
+}
+
 void SchedulePage::onDateSelected(const QDate &date)
 {
     if (date.month() != m_calendar->monthShown() || date.year() != m_calendar->yearShown()) {
@@ -491,10 +505,6 @@ void SchedulePage::onAddSchedule()
             // AI 요약 무효화
             DataManager::instance().invalidateSummary(m_userId, data["date"].toString());
 
-            // UI 갱신
-            updateCalendarSchedules();
-            loadSchedulesForDate(m_selectedDate);
-
             QMessageBox::information(this, "일정 추가", "일정이 성공적으로 추가되었습니다.");
         } else {
             QMessageBox::warning(this, "오류", "일정 추가에 실패했습니다.");
@@ -544,10 +554,6 @@ void SchedulePage::onEditSchedule()
             DataManager::instance().invalidateSummary(m_userId, scheduleData["date"].toString());
             DataManager::instance().invalidateSummary(m_userId, data["date"].toString());
 
-            // UI 갱신
-            updateCalendarSchedules();
-            loadSchedulesForDate(m_selectedDate);
-
             QMessageBox::information(this, "일정 수정", "일정이 성공적으로 수정되었습니다.");
         } else {
             QMessageBox::warning(this, "오류", "일정 수정에 실패했습니다.");
@@ -585,10 +591,6 @@ void SchedulePage::onDeleteSchedule()
             // AI 요약 무효화
             DataManager::instance().invalidateSummary(m_userId, dateStr);
 
-            // UI 갱신
-            updateCalendarSchedules();
-            loadSchedulesForDate(m_selectedDate);
-
             QMessageBox::information(this, "삭제 완료", "일정이 삭제되었습니다.");
         } else {
             QMessageBox::warning(this, "오류", "일정 삭제에 실패했습니다.");
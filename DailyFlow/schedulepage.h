@@ -51,6 +51,7 @@ public:
 
 public slots:
     void applyTheme(bool isDarkMode);
+    void refresh();   // 캘린더 표시와 선택한 날짜의 일정 목록을 다시 조회
 
 private slots:
     void onDateSelected(const QDate &date);
@@ -1,12 +1,41 @@
 #include "settingspage.h"
 #include "ui_settingspage.h"
 #include "datamanager.h"
+#include "aiservice.h"
+#include "envloader.h"
 #include <QMessageBox>
+#include <QHeaderView>
+#include <QTableWidgetItem>
 #include <QInputDialog>
 #include <QSettings>
 #include <QPalette>
 #include <QApplication>
 
+namespace {
+
+// LLM 엔드포인트들의 "<이름><suffix>" 카운터 합계
+// 이름을 정확히 맞추므로 날씨, .ttfb/.handshake 지연, home./startup. 지표는 섞이지 않음
+qint64 sumLlmCounters(const QVariantMap &row, const QStringList &endpoints, const QString &suffix)
+{
+    qint64 total = 0;
+    for (const QString &endpoint : endpoints) {
+        total += row.value(endpoint + suffix).toLongLong();
+    }
+    return total;
+}
+
+QString hitRatio(const QVariantMap &row, const QString &target)
+{
+    qint64 hits = row.value(target + ".cache_hits").toLongLong();
+    qint64 misses = row.value(target + ".cache_misses").toLongLong();
+    if (hits + misses == 0) {
+        return "-";
+    }
+    return QString("%1%").arg(qRound(100.0 * hits / (hits + misses)));
+}
+
+} // namespace
+
 SettingsPage::SettingsPage(int userId, QWidget *parent)  // QString에서 int로 변경
     : QWidget(parent)
     , ui(new Ui::SettingsPage)
@@ -28,12 +57,22 @@ SettingsPage::SettingsPage(int userId, QWidget *parent)  // QString에서 int로
     connect(ui->btnChangePassword, &QPushButton::clicked, this, &SettingsPage::onChangePasswordClicked);
     connect(ui->btnDeleteAccount, &QPushButton::clicked, this, &SettingsPage::onDeleteAccountClicked);
     connect(ui->checkDarkMode, &QCheckBox::toggled, this, &SettingsPage::onThemeToggled);
+    connect(ui->btnRefreshDiagnostics, &QPushButton::clicked, this, &SettingsPage::loadDiagnostics);
 
     // 저장된 테마 설정 불러오기
     QSettings settings("DailyFlow", "Settings");
     bool isDarkMode = settings.value("darkMode", false).toBool();
     ui->checkDarkMode->setChecked(isDarkMode);
     applyDarkMode(isDarkMode);
+
+    // AI 사용량 진단 패널
+    QStringList headers = {"날짜", "AI 호출", "실패", "평균 지연", "토큰 (입력/출력)", "예상 비용",
+                           "요약 캐시", "날씨 캐시", "로컬 대체"};
+    ui->tableUsage->setColumnCount(headers.size());
+    ui->tableUsage->setHorizontalHeaderLabels(headers);
+    ui->tableUsage->verticalHeader()->setVisible(false);
+    ui->tableUsage->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    loadDiagnostics();
 }
 
 SettingsPage::~SettingsPage()
@@ -55,6 +94,70 @@ void SettingsPage::loadUserInfo()
     }
 }
 
+void SettingsPage::loadDiagnostics()
+{
+    // 아직 저장되지 않은 카운터까지 반영한 뒤 조회
+    AIService::instance().flushUsage();
+
+    // 모델 가격 (USD / 1M 토큰, 기본값은 gpt-4o-mini)
+    double inputPrice = EnvLoader::get("OPENAI_INPUT_PRICE_PER_1M", "0.15").toDouble();
+    double outputPrice = EnvLoader::get("OPENAI_OUTPUT_PRICE_PER_1M", "0.60").toDouble();
+
+    const QStringList llmEndpoints = AIService::instance().llmEndpointNames();
+    const QList<QVariantMap> rollups = DataManager::instance().getUsageRollups(7);
+    ui->tableUsage->setRowCount(rollups.size());
+    for (int i = 0; i < rollups.size(); ++i) {
+        const QVariantMap &row = rollups[i];
+        qint64 calls = sumLlmCounters(row, llmEndpoints, ".calls");
+        qint64 failures = sumLlmCounters(row, llmEndpoints, ".failures");
+        qint64 latencyCount = sumLlmCounters(row, llmEndpoints, ".latency.count");
+        qint64 latencyTotal = sumLlmCounters(row, llmEndpoints, ".latency.total_ms");
+        qint64 promptTokens = row.value("openai.prompt_tokens").toLongLong();
+        qint64 completionTokens = row.value("openai.completion_tokens").toLongLong();
+        double cost = (promptTokens * inputPrice + completionTokens * outputPrice) / 1000000.0;
+        qint64 fallbacks = row.value("summary.local_fallbacks").toLongLong();
+
+        QStringList cells = {
+            row["date"].toString(),
+            QString::number(calls),
+            QString::number(failures),
+            latencyCount > 0 ? QString("%1 ms").arg(latencyTotal / latencyCount) : QString("-"),
+            QString("%1 / %2").arg(promptTokens).arg(completionTokens),
+            QString("$%1").arg(cost, 0, 'f', 4),
+            hitRatio(row, "summary"),
+            hitRatio(row, "weather"),
+            QString::number(fallbacks)
+        };
+        for (int column = 0; column < cells.size(); ++column) {
+            ui->tableUsage->setItem(i, column, new QTableWidgetItem(cells[column]));
+        }
+    }
+
+    // 이번 실행 중의 엔드포인트별 상태와 지연 분위수
+    QStringList lines;
+    for (const QVariantMap &status : AIService::instance().endpointStatus()) {
+        QString line = QString("%1: %2 · 호출 %3 · 실패 %4 · 재시도 %5")
+                           .arg(status["endpoint"].toString(), status["state"].toString())
+                           .arg(status["calls"].toLongLong())
+                           .arg(status["failures"].toLongLong())
+                           .arg(status["retries"].toLongLong());
+        if (status["p50LatencyMs"].toLongLong() >= 0) {
+            line += QString(" · p50 %1ms · p95 %2ms")
+                        .arg(status["p50LatencyMs"].toLongLong())
+                        .arg(status["p95LatencyMs"].toLongLong());
+        }
+        lines.append(line);
+    }
+
+    // 이번 실행 중 진행 중인 요청에 합류해서 네트워크 호출을 아낀 횟수
+    const QMap<QString, qint64> stats = AIService::instance().requestStats();
+    lines.append(QString("중복 제거: 요약 %1/%2 · 운세 %3/%4 · 날씨 %5")
+                     .arg(stats.value("summary.deduplicated")).arg(stats.value("summary.requests"))
+                     .arg(stats.value("fortune.deduplicated")).arg(stats.value("fortune.requests"))
+                     .arg(stats.value("weather.deduplicated")));
+    ui->labelEndpointStatus->setText(lines.join("\n"));
+}
+
 void SettingsPage::setEditMode(bool enabled)
 {
     m_isEditMode = enabled;
@@ -26,6 +26,7 @@ private slots:
     void onChangePasswordClicked();
     void onDeleteAccountClicked();
     void onThemeToggled(bool checked);
+    void loadDiagnostics();   // AI 사용량 일별 집계와 엔드포인트 상태 표시
 
 private:
     Ui::SettingsPage *ui;
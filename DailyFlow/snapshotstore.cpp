@@ -0,0 +1,220 @@
+#include "snapshotstore.h"
+#include "datamanager.h"
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QTimer>
+#include <QDebug>
+
+namespace {
+const quint32 SNAPSHOT_MAGIC = 0x44465350;   // "DFSP"
+const quint32 SNAPSHOT_VERSION = 1;          // 저장 항목이 바뀌면 올릴 것
+const int HEADER_SIZE = 16;                  // magic + version + size + checksum
+const int SAVE_DELAY_MS = 500;
+const int UPCOMING_DAYS = 7;
+}
+
+SnapshotStore& SnapshotStore::instance()
+{
+    static SnapshotStore instance;
+    return instance;
+}
+
+SnapshotStore::SnapshotStore() : m_saveTimer(new QTimer(this))
+{
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY_MS);
+    connect(m_saveTimer, &QTimer::timeout, this, &SnapshotStore::flush);
+}
+
+SnapshotStore::~SnapshotStore()
+{
+}
+
+void SnapshotStore::watchDatabase()
+{
+    if (m_watchingDatabase) {
+        return;
+    }
+    m_watchingDatabase = true;
+
+    // 스냅샷에 들어가는 데이터가 바뀌면 다시 저장
+    DataManager &dm = DataManager::instance();
+    connect(&dm, &DataManager::scheduleChanged, this, &SnapshotStore::scheduleSave);
+    connect(&dm, &DataManager::userInfoChanged, this, &SnapshotStore::scheduleSave);
+    connect(&dm, &DataManager::summaryChanged, this, [this](int userId, const QString &date) {
+        Q_UNUSED(date)
+        scheduleSave(userId);
+    });
+}
+
+const SnapshotStore::Snapshot& SnapshotStore::snapshot(int userId)
+{
+    auto it = m_cache.find(userId);
+    if (it == m_cache.end()) {
+        it = m_cache.insert(userId, readFile(userId));
+    }
+    return it.value();
+}
+
+void SnapshotStore::scheduleSave(int userId)
+{
+    watchDatabase();
+    m_pendingUsers.insert(userId);
+    m_saveTimer->start();
+}
+
+void SnapshotStore::flush()
+{
+    m_saveTimer->stop();
+
+    const QSet<int> users = m_pendingUsers;
+    m_pendingUsers.clear();
+    for (int userId : users) {
+        save(userId);
+    }
+}
+
+bool SnapshotStore::save(int userId)
+{
+    watchDatabase();
+    Snapshot snapshot = buildFromDatabase(userId);
+
+    // 탈퇴 등으로 사용자가 없으면 스냅샷도 삭제
+    if (snapshot.userInfo.isEmpty()) {
+        m_cache.remove(userId);
+        QFile::remove(snapshotPath(userId));
+        return false;
+    }
+
+    m_cache.insert(userId, snapshot);
+    return writeFile(userId, snapshot);
+}
+
+QString SnapshotStore::snapshotPath(int userId) const
+{
+    return QString("snapshots/user_%1.snap").arg(userId);
+}
+
+SnapshotStore::Snapshot SnapshotStore::buildFromDatabase(int userId) const
+{
+    DataManager &dm = DataManager::instance();
+    QDate today = QDate::currentDate();
+
+    Snapshot snapshot;
+    snapshot.builtFor = today;
+    snapshot.userInfo = dm.getUserInfo(userId);
+    if (snapshot.userInfo.isEmpty()) {
+        return snapshot;
+    }
+
+    snapshot.upcomingSchedules = dm.getSchedulesForNextDays(userId, UPCOMING_DAYS);
+
+    snapshot.year = today.year();
+    snapshot.month = today.month();
+    const QList<QVariantMap> monthSchedules = dm.getSchedulesByMonth(userId, snapshot.year, snapshot.month);
+    for (const QVariantMap &schedule : monthSchedules) {
+        snapshot.monthCounts[QDate::fromString(schedule["date"].toString(), "yyyy-MM-dd")]++;
+    }
+
+    QVariantMap latest = dm.getLatestSummary(userId);
+    snapshot.summaryDate = latest["date"].toString();
+    snapshot.summary = latest["summary"].toString();
+
+    snapshot.valid = true;
+    return snapshot;
+}
+
+SnapshotStore::Snapshot SnapshotStore::readFile(int userId) const
+{
+    Snapshot snapshot;
+
+    QFile file(snapshotPath(userId));
+    if (!file.open(QIODevice::ReadOnly) || file.size() < HEADER_SIZE) {
+        return snapshot;
+    }
+
+    // 파일 전체를 매핑해서 복사 없이 헤더 검사와 역직렬화를 수행
+    uchar *mapped = file.map(0, file.size());
+    if (!mapped) {
+        qDebug() << "Snapshot: failed to map" << file.fileName();
+        return snapshot;
+    }
+
+    QByteArray header = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), HEADER_SIZE);
+    QDataStream headerStream(header);
+    quint32 magic = 0, version = 0, payloadSize = 0, checksum = 0;
+    headerStream >> magic >> version >> payloadSize >> checksum;
+
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+        payloadSize != quint64(file.size()) - HEADER_SIZE) {
+        qDebug() << "Snapshot: ignoring incompatible file" << file.fileName();
+        file.unmap(mapped);
+        return snapshot;
+    }
+
+    QByteArray payload = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped) + HEADER_SIZE,
+                                                 payloadSize);
+    if (qChecksum(payload) != checksum) {
+        qDebug() << "Snapshot: checksum mismatch" << file.fileName();
+        file.unmap(mapped);
+        return snapshot;
+    }
+
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_6_0);
+    in >> snapshot.builtFor
+        >> snapshot.userInfo
+        >> snapshot.upcomingSchedules
+        >> snapshot.year >> snapshot.month
+        >> snapshot.monthCounts
+        >> snapshot.summaryDate
+        >> snapshot.summary;
+
+    snapshot.valid = (in.status() == QDataStream::Ok);
+    file.unmap(mapped);
+
+    if (!snapshot.valid) {
+        return Snapshot();
+    }
+    return snapshot;
+}
+
+bool SnapshotStore::writeFile(int userId, const Snapshot &snapshot) const
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << snapshot.builtFor
+        << snapshot.userInfo
+        << snapshot.upcomingSchedules
+        << snapshot.year << snapshot.month
+        << snapshot.monthCounts
+        << snapshot.summaryDate
+        << snapshot.summary;
+
+    QByteArray header;
+    QDataStream headerStream(&header, QIODevice::WriteOnly);
+    headerStream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION
+                 << quint32(payload.size()) << quint32(qChecksum(payload));
+
+    QDir().mkpath("snapshots");
+
+    // 쓰는 도중 종료되어도 기존 스냅샷이 깨지지 않도록 QSaveFile 사용
+    QSaveFile file(snapshotPath(userId));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Snapshot: cannot write" << file.fileName();
+        return false;
+    }
+    file.write(header);
+    file.write(payload);
+
+    if (!file.commit()) {
+        qDebug() << "Snapshot: commit failed" << file.fileName();
+        return false;
+    }
+
+    qDebug() << "Snapshot saved for user" << userId << "(" << header.size() + payload.size() << "bytes )";
+    return true;
+}
@@ -0,0 +1,68 @@
+#ifndef SNAPSHOTSTORE_H
+#define SNAPSHOTSTORE_H
+
+#include <QObject>
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QVariantMap>
+
+class QTimer;
+
+// 로그인 직후 DB 조회 없이 첫 화면을 그리기 위한 사용자별 바이너리 스냅샷
+// 파일 구조: [magic][version][payload 크기][checksum][payload(QDataStream)]
+class SnapshotStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Snapshot {
+        bool valid = false;
+        QDate builtFor;                         // 스냅샷을 만든 기준 날짜
+        QVariantMap userInfo;                   // getUserInfo 결과
+        QList<QVariantMap> upcomingSchedules;   // 기준 날짜부터 7일간의 일정
+        int year = 0;                           // monthCounts가 가리키는 월
+        int month = 0;
+        QMap<QDate, int> monthCounts;           // 캘린더 표시용 날짜별 일정 개수
+        QString summaryDate;                    // 마지막 AI 요약의 날짜
+        QString summary;                        // 마지막 AI 요약
+    };
+
+    static SnapshotStore& instance();
+
+    // 스냅샷 조회 (처음 한 번만 파일을 mmap 해서 읽고 이후에는 메모리에서 반환)
+    const Snapshot& snapshot(int userId);
+
+    // 변경이 생겼을 때 호출 - 짧은 시간 안의 변경은 한 번의 쓰기로 모음
+    void scheduleSave(int userId);
+
+    // 예약된 쓰기를 즉시 수행 (창 닫힐 때)
+    void flush();
+
+    // DB에서 다시 만들어 즉시 저장
+    bool save(int userId);
+
+    // DataManager 의 변경 알림 구독 - DB 를 연 뒤에 호출 (여러 번 불러도 한 번만 연결)
+    // 스냅샷 읽기는 DataManager 를 만들지 않으므로 첫 화면이 DB 열기를 기다리지 않음
+    void watchDatabase();
+
+private:
+    SnapshotStore();
+    ~SnapshotStore();
+    SnapshotStore(const SnapshotStore&) = delete;
+    SnapshotStore& operator=(const SnapshotStore&) = delete;
+
+    QString snapshotPath(int userId) const;
+    Snapshot readFile(int userId) const;
+    bool writeFile(int userId, const Snapshot &snapshot) const;
+    Snapshot buildFromDatabase(int userId) const;
+
+    QHash<int, Snapshot> m_cache;
+    QSet<int> m_pendingUsers;
+    QTimer *m_saveTimer;
+    bool m_watchingDatabase = false;
+};
+
+#endif // SNAPSHOTSTORE_H
@@ -0,0 +1,63 @@
+#include "sseparser.h"
+
+QList<QByteArray> SseParser::feed(const QByteArray &chunk)
+{
+    QList<QByteArray> events;
+    m_buffer.append(chunk);
+
+    int start = 0;
+    int newline;
+    while ((newline = m_buffer.indexOf('\n', start)) != -1) {
+        processLine(m_buffer.mid(start, newline - start), events);
+        start = newline + 1;
+    }
+    m_buffer.remove(0, start);
+
+    return events;
+}
+
+QList<QByteArray> SseParser::finish()
+{
+    QList<QByteArray> events;
+    if (!m_buffer.isEmpty()) {
+        processLine(m_buffer, events);
+        m_buffer.clear();
+    }
+    processLine(QByteArray(), events);   // 마지막 이벤트 마무리
+    return events;
+}
+
+void SseParser::processLine(QByteArray line, QList<QByteArray> &events)
+{
+    if (line.endsWith('\r')) {
+        line.chop(1);
+    }
+
+    // 빈 줄: 지금까지 모은 data 로 이벤트 완성
+    if (line.isEmpty()) {
+        if (m_hasData) {
+            events.append(m_data);
+        }
+        m_data.clear();
+        m_hasData = false;
+        return;
+    }
+
+    // ':' 로 시작하면 주석 (keep-alive 용)
+    if (line.startsWith(':')) {
+        return;
+    }
+
+    if (line.startsWith("data:")) {
+        QByteArray value = line.mid(5);
+        if (value.startsWith(' ')) {
+            value.remove(0, 1);
+        }
+        if (m_hasData) {
+            m_data.append('\n');
+        }
+        m_data.append(value);
+        m_hasData = true;
+    }
+    // event:, id:, retry: 필드는 OpenAI 스트림에서 쓰지 않으므로 무시
+}
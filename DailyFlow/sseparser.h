@@ -0,0 +1,26 @@
+#ifndef SSEPARSER_H
+#define SSEPARSER_H
+
+#include <QByteArray>
+#include <QList>
+
+// Server-Sent Events(text/event-stream) 응답을 도착하는 조각 단위로 파싱
+// 이벤트 하나가 완성될 때마다(빈 줄) 그 이벤트의 data 필드를 돌려줌
+class SseParser
+{
+public:
+    // 새로 받은 조각을 넣고, 이번에 완성된 이벤트들의 data 를 반환
+    QList<QByteArray> feed(const QByteArray &chunk);
+
+    // 스트림 종료 시 빈 줄 없이 끝난 마지막 이벤트 처리
+    QList<QByteArray> finish();
+
+private:
+    void processLine(QByteArray line, QList<QByteArray> &events);
+
+    QByteArray m_buffer;    // 아직 줄바꿈이 오지 않은 부분
+    QByteArray m_data;      // 현재 이벤트의 data (여러 줄이면 \n 으로 연결)
+    bool m_hasData = false;
+};
+
+#endif // SSEPARSER_H
@@ -0,0 +1,57 @@
+#include "startuptrace.h"
+#include "aimetrics.h"
+#include <QElapsedTimer>
+#include <QSet>
+#include <QDebug>
+
+namespace {
+
+QElapsedTimer &traceClock()
+{
+    static QElapsedTimer timer;
+    return timer;
+}
+
+// 이름별 첫 기록만 지표로 남김 (로그아웃 후 다시 로그인해도 시작 지표는 처음 한 번만)
+bool firstTime(const QString &name)
+{
+    static QSet<QString> recorded;
+    if (recorded.contains(name)) {
+        return false;
+    }
+    recorded.insert(name);
+    return true;
+}
+
+} // namespace
+
+namespace StartupTrace {
+
+void start()
+{
+    traceClock().start();
+}
+
+qint64 elapsedMs()
+{
+    return traceClock().isValid() ? traceClock().elapsed() : 0;
+}
+
+void mark(const QString &name)
+{
+    qint64 ms = elapsedMs();
+    qDebug().noquote() << QString("[trace] +%1ms %2").arg(ms).arg(name);
+    if (firstTime(name)) {
+        AIMetrics::instance().recordLatency("startup." + name, ms);
+    }
+}
+
+void span(const QString &name, qint64 durationMs)
+{
+    qDebug().noquote() << QString("[trace] +%1ms %2 (%3ms)").arg(elapsedMs()).arg(name).arg(durationMs);
+    if (firstTime(name)) {
+        AIMetrics::instance().recordLatency("startup." + name, durationMs);
+    }
+}
+
+} // namespace StartupTrace
@@ -0,0 +1,18 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QString>
+#include <QtGlobal>
+
+// 프로그램 시작 시점 기준의 구간 기록 (로그로 시작 과정의 타임라인을 확인)
+// 예: "[trace] +412ms main_window.shown"
+namespace StartupTrace {
+
+void start();                       // main() 맨 앞에서 한 번 호출
+qint64 elapsedMs();                 // start() 이후 경과 시간
+void mark(const QString &name);     // 경과 시간을 로그로 남기고 "startup.<name>" 지연으로 기록 (이름별 첫 번째만)
+void span(const QString &name, qint64 durationMs);   // 걸린 시간과 함께 남기고 "startup.<name>" 에는 걸린 시간을 기록
+
+} // namespace StartupTrace
+
+#endif // STARTUPTRACE_H
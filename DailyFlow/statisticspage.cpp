@@ -0,0 +1,167 @@
+#include "statisticspage.h"
+#include "ui_statisticspage.h"
+#include "datamanager.h"
+#include "schedulecolumns.h"
+#include <QDate>
+#include <QElapsedTimer>
+#include <QHeaderView>
+#include <QLocale>
+#include <QTableWidgetItem>
+#include <QDebug>
+
+StatisticsPage::StatisticsPage(int userId, QWidget *parent)
+    : QWidget(parent)
+    , ui(new Ui::StatisticsPage)
+    , m_userId(userId)
+{
+    ui->setupUi(this);
+
+    ui->yearSpinBox->setValue(QDate::currentDate().year());
+
+    ui->categoryTable->setColumnCount(5);
+    ui->categoryTable->setHorizontalHeaderLabels({"카테고리", "일정 수", "시간", "비율", "자주 쓴 제목"});
+    ui->categoryTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->categoryTable->verticalHeader()->setVisible(false);
+
+    ui->weekdayTable->setColumnCount(2);
+    ui->weekdayTable->setHorizontalHeaderLabels({"요일", "일정 수"});
+    ui->weekdayTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->weekdayTable->verticalHeader()->setVisible(false);
+
+    ui->weeklyTable->verticalHeader()->setVisible(false);
+
+    connect(ui->yearSpinBox, &QSpinBox::valueChanged, this, &StatisticsPage::onYearChanged);
+}
+
+StatisticsPage::~StatisticsPage()
+{
+    delete ui;
+}
+
+void StatisticsPage::markDirty()
+{
+    m_dirty = true;
+    if (isVisible()) {
+        refreshStatistics();
+    }
+}
+
+void StatisticsPage::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (m_dirty) {
+        refreshStatistics();
+    }
+}
+
+void StatisticsPage::onYearChanged(int year)
+{
+    Q_UNUSED(year)
+    refreshStatistics();
+}
+
+void StatisticsPage::refreshStatistics()
+{
+    m_dirty = false;
+
+    int year = ui->yearSpinBox->value();
+    QDate firstDate(year, 1, 1);
+    QDate lastDate(year, 12, 31);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    ScheduleColumns columns = DataManager::instance().getScheduleColumns(
+        m_userId,
+        firstDate.toString("yyyy-MM-dd"),
+        lastDate.toString("yyyy-MM-dd")
+        );
+    qint64 loadMs = timer.elapsed();
+
+    // 주차는 1월 1일이 속한 주의 월요일부터 계산
+    qint32 firstDay = static_cast<qint32>(firstDate.addDays(1 - firstDate.dayOfWeek()).toJulianDay());
+    int weeks = static_cast<int>((lastDate.toJulianDay() - firstDay) / 7 + 1);
+
+    QVector<qint32> durations = ScheduleStats::durations(columns);
+    showCategoryTable(columns, durations);
+    showWeekdayTable(columns);
+    showWeeklyTable(columns, durations, firstDay, weeks);
+
+    qint64 totalMs = timer.elapsed();
+    ui->elapsedLabel->setText(QString("일정 %1개 · 조회 %2ms · 집계 %3ms")
+                                  .arg(columns.size())
+                                  .arg(loadMs)
+                                  .arg(totalMs - loadMs));
+
+    qDebug() << "Statistics for" << year << ":" << columns.size() << "schedules,"
+             << loadMs << "ms load," << totalMs - loadMs << "ms aggregate";
+}
+
+void StatisticsPage::showCategoryTable(const ScheduleColumns &columns, const QVector<qint32> &durations)
+{
+    QVector<qint32> counts = ScheduleStats::countPerCategory(columns);
+    QVector<qint64> minutes = ScheduleStats::minutesPerCategory(columns, durations);
+    QVector<QList<ScheduleStats::TitleCount>> topTitles = ScheduleStats::topTitlesPerCategory(columns, 3);
+
+    qint64 totalMinutes = 0;
+    for (qint64 value : minutes) {
+        totalMinutes += value;
+    }
+
+    ui->categoryTable->setRowCount(columns.categories.size());
+    for (int i = 0; i < columns.categories.size(); ++i) {
+        QString category = columns.categories[i].isEmpty() ? "없음" : columns.categories[i];
+        double share = totalMinutes > 0 ? 100.0 * minutes[i] / totalMinutes : 0.0;
+
+        ui->categoryTable->setItem(i, 0, new QTableWidgetItem(category));
+        ui->categoryTable->setItem(i, 1, new QTableWidgetItem(QString::number(counts[i])));
+        ui->categoryTable->setItem(i, 2, new QTableWidgetItem(QString::number(minutes[i] / 60.0, 'f', 1)));
+        ui->categoryTable->setItem(i, 3, new QTableWidgetItem(QString::number(share, 'f', 1) + "%"));
+
+        QStringList titles;
+        for (const ScheduleStats::TitleCount &entry : topTitles[i]) {
+            titles << QString("%1 (%2)").arg(entry.title).arg(entry.count);
+        }
+        ui->categoryTable->setItem(i, 4, new QTableWidgetItem(titles.join(", ")));
+    }
+}
+
+void StatisticsPage::showWeekdayTable(const ScheduleColumns &columns)
+{
+    QVector<qint32> counts = ScheduleStats::countPerWeekday(columns);
+    QLocale korean(QLocale::Korean);
+
+    ui->weekdayTable->setRowCount(7);
+    for (int i = 0; i < 7; ++i) {
+        ui->weekdayTable->setItem(i, 0, new QTableWidgetItem(korean.dayName(i + 1, QLocale::ShortFormat)));
+        ui->weekdayTable->setItem(i, 1, new QTableWidgetItem(QString::number(counts[i])));
+    }
+}
+
+void StatisticsPage::showWeeklyTable(const ScheduleColumns &columns, const QVector<qint32> &durations,
+                                     qint32 firstDay, int weeks)
+{
+    const int categoryCount = columns.categories.size();
+    QVector<qint64> matrix = ScheduleStats::minutesPerWeekAndCategory(columns, durations, firstDay, weeks);
+
+    QStringList headers{"주차"};
+    for (const QString &category : columns.categories) {
+        headers << (category.isEmpty() ? "없음" : category);
+    }
+
+    ui->weeklyTable->clear();
+    ui->weeklyTable->setColumnCount(headers.size());
+    ui->weeklyTable->setHorizontalHeaderLabels(headers);
+    ui->weeklyTable->setRowCount(weeks);
+
+    for (int week = 0; week < weeks; ++week) {
+        QDate weekStart = QDate::fromJulianDay(firstDay + week * 7);
+        ui->weeklyTable->setItem(week, 0, new QTableWidgetItem(weekStart.toString("MM/dd")));
+
+        for (int c = 0; c < categoryCount; ++c) {
+            qint64 minutes = matrix[week * categoryCount + c];
+            QString text = minutes > 0 ? QString::number(minutes / 60.0, 'f', 1) : QString();
+            ui->weeklyTable->setItem(week, c + 1, new QTableWidgetItem(text));
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef STATISTICSPAGE_H
+#define STATISTICSPAGE_H
+
+#include <QWidget>
+#include <QVector>
+
+namespace Ui {
+class StatisticsPage;
+}
+
+struct ScheduleColumns;
+
+class StatisticsPage : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StatisticsPage(int userId, QWidget *parent = nullptr);
+    ~StatisticsPage();
+
+public slots:
+    void markDirty();   // 일정이 바뀌면 다음 표시 때 다시 계산
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private slots:
+    void onYearChanged(int year);
+
+private:
+    Ui::StatisticsPage *ui;
+    int m_userId;
+    bool m_dirty = true;
+
+    void refreshStatistics();
+    void showCategoryTable(const ScheduleColumns &columns, const QVector<qint32> &durations);
+    void showWeekdayTable(const ScheduleColumns &columns);
+    void showWeeklyTable(const ScheduleColumns &columns, const QVector<qint32> &durations,
+                         qint32 firstDay, int weeks);
+};
+
+#endif // STATISTICSPAGE_H